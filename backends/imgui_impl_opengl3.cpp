@@ -6,6 +6,9 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [x] Renderer: Large meshes support (64k+ vertices) with 16-bit indices (Desktop OpenGL only).
+//  [X] Renderer: Font atlas partial texture updates (ImFontAtlas::TexUpdates[]), enabling ImFontAtlasFlags_IncrementalGlyphs.
+//  [X] Renderer: Signed distance field fonts (ImFontAtlasFlags_SDF). Not available with ES 2.0 (WebGL 1.0), which lacks fwidth() without an extension.
+//  [X] Renderer: Single channel font texture (GL 3.3+, ES 3.0+, not WebGL), unless ImFontAtlas::TexPixelsUseColors is set.
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -22,6 +25,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2024-05-06: OpenGL: Upload font atlas as a single channel GL_R8 texture sampled with a (1,1,1,R) swizzle on GL 3.3+/ES 3.0+ (not WebGL), unless io.Fonts->TexPixelsUseColors is set. 4x less texture memory.
+//  2024-05-06: OpenGL: Sample font atlas through a distance field function when ImFontAtlasFlags_SDF is set, enable ImGuiBackendFlags_RendererHasSdfFonts flag (not on ES 2.0).
+//  2024-05-06: OpenGL: Upload ImFontAtlas::TexUpdates[] regions with glTexSubImage2D() and resize font texture when needed, enable ImGuiBackendFlags_RendererHasTexUpdates flag.
 //  2024-04-16: OpenGL: Detect ES3 contexts on desktop based on version string, to e.g. avoid calling glPolygonMode() on them. (#7447)
 //  2024-01-09: OpenGL: Update GL3W based imgui_impl_opengl3_loader.h to load "libGL.so" and variants, fixing regression on distros missing a symlink.
 //  2023-11-08: OpenGL: Update GL3W based imgui_impl_opengl3_loader.h to load "libGL.so" instead of "libGL.so.1", accommodating for NetBSD systems having only "libGL.so.3" available. (#6983)
@@ -204,6 +210,21 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 3.3+ and GL ES 3.0+ have texture swizzle, which we use to sample a single channel font texture as (1,1,1,R)
+// WebGL 2 doesn't have GL_TEXTURE_SWIZZLE_XXX: we keep uploading the font texture as RGBA32 there.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_3)) && !defined(__EMSCRIPTEN__)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+#ifndef GL_TEXTURE_SWIZZLE_R // Not in our minimal loader
+#define GL_UNPACK_ALIGNMENT               0x0CF5
+#define GL_RED                            0x1903
+#define GL_R8                             0x8229
+#define GL_TEXTURE_SWIZZLE_R              0x8E42
+#define GL_TEXTURE_SWIZZLE_G              0x8E43
+#define GL_TEXTURE_SWIZZLE_B              0x8E44
+#define GL_TEXTURE_SWIZZLE_A              0x8E45
+#endif
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -223,9 +244,12 @@ struct ImGui_ImplOpenGL3_Data
     bool            GlProfileIsCompat;
     GLint           GlProfileMask;
     GLuint          FontTexture;
+    int             FontTextureWidth, FontTextureHeight;
+    bool            FontTextureIsAlpha8;     // Single channel GL_R8 texture, sampled as (1,1,1,R)
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationSdfMode;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -234,6 +258,7 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      IndexBufferSize;
     bool            HasPolygonMode;
     bool            HasClipOrigin;
+    bool            HasTextureSwizzle;
     bool            UseBufferSubData;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
@@ -270,6 +295,9 @@ struct ImGui_ImplOpenGL3_VtxAttribState
 };
 #endif
 
+// Forward Declarations
+static void ImGui_ImplOpenGL3_UpdateFontsTexture();
+
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 {
@@ -337,6 +365,9 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     if (bd->GlVersion >= 320)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates;     // We can upload ImFontAtlas::TexUpdates[], allowing for incremental glyphs rasterization.
+    if (!bd->GlProfileIsES2)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfFonts;   // We can apply a distance field function to the font atlas, allowing for ImFontAtlasFlags_SDF.
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
     // Note: GLSL version is NOT the same as GL version. Leave this to nullptr if unsure.
@@ -366,6 +397,9 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     bd->HasPolygonMode = (!bd->GlProfileIsES2 && !bd->GlProfileIsES3);
 #endif
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    bd->HasTextureSwizzle = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_HAS_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -389,7 +423,7 @@ void    ImGui_ImplOpenGL3_Shutdown()
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTexUpdates | ImGuiBackendFlags_RendererHasSdfFonts);
     IM_DELETE(bd);
 }
 
@@ -453,6 +487,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     };
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
+    glUniform1i(bd->AttribLocationSdfMode, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
@@ -489,6 +524,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
+    // Upload font atlas regions modified during NewFrame()
+    if (bd->FontTexture && ImGui::GetIO().Fonts->TexUpdates.Size > 0)
+        ImGui_ImplOpenGL3_UpdateFontsTexture();
+
     // Backup GL state
     GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
     glActiveTexture(GL_TEXTURE0);
@@ -537,6 +576,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
+    // With ImFontAtlasFlags_SDF, the font texture is sampled through a distance field function (SdfMode is reset to 0 by ImGui_ImplOpenGL3_SetupRenderState())
+    const bool font_is_sdf = (ImGui::GetIO().Fonts->Flags & ImFontAtlasFlags_SDF) != 0;
+    GLint last_sdf_mode = 0;
+
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
@@ -585,7 +628,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    last_sdf_mode = 0;
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -602,6 +648,12 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 
                 // Bind texture, Draw
                 GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                const GLint sdf_mode = (font_is_sdf && (GLuint)(intptr_t)pcmd->GetTexID() == bd->FontTexture) ? 1 : 0;
+                if (sdf_mode != last_sdf_mode)
+                {
+                    GL_CALL(glUniform1i(bd->AttribLocationSdfMode, sdf_mode));
+                    last_sdf_mode = sdf_mode;
+                }
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
@@ -657,15 +709,40 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     (void)bd; // Not all compilation paths use this
 }
 
+// Allocate and upload whole font texture, to currently bound GL_TEXTURE_2D
+static void ImGui_ImplOpenGL3_TexImageFonts(int width, int height, const unsigned char* pixels)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    if (bd->FontTextureIsAlpha8)
+    {
+        GLint last_unpack_alignment;
+        GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment));
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels));
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment));
+        return;
+    }
+#endif
+    GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    (void)bd;
+}
+
 bool ImGui_ImplOpenGL3_CreateFontsTexture()
 {
     ImGuiIO& io = ImGui::GetIO();
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
     // Build texture atlas
+    // Load as Alpha8 when we can sample it as (1,1,1,R) with texture swizzle, unless user or FreeType rendered colored pixels.
+    // Otherwise load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders.
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    bd->FontTextureIsAlpha8 = bd->HasTextureSwizzle && !io.Fonts->TexPixelsUseColors;
+    if (bd->FontTextureIsAlpha8)
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    else
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
 
     // Upload texture to graphics system
     // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
@@ -675,10 +752,22 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     GL_CALL(glBindTexture(GL_TEXTURE_2D, bd->FontTexture));
     GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
     GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    if (bd->FontTextureIsAlpha8)
+    {
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE));
+        GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED));
+    }
+#endif
 #ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
     GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
 #endif
-    GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    ImGui_ImplOpenGL3_TexImageFonts(width, height, pixels);
+    bd->FontTextureWidth = width;
+    bd->FontTextureHeight = height;
+    io.Fonts->TexUpdates.resize(0);
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
@@ -689,6 +778,66 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     return true;
 }
 
+// Upload regions of the font atlas modified since texture creation (e.g. glyphs rasterized by ImFontAtlasFlags_IncrementalGlyphs)
+// We keep the same texture name when the atlas grows, so ImTextureID already stored in this frame's draw commands stay valid.
+static void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+
+    unsigned char* pixels;
+    int width, height;
+    if (bd->FontTextureIsAlpha8)
+        atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    else
+        atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+    const GLenum format = bd->FontTextureIsAlpha8 ? GL_RED : GL_RGBA;
+#else
+    const GLenum format = GL_RGBA;
+#endif
+    const size_t bytes_per_pixel = bd->FontTextureIsAlpha8 ? 1 : 4;
+
+    GLint last_texture;
+    GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, bd->FontTexture));
+    if (width != bd->FontTextureWidth || height != bd->FontTextureHeight)
+    {
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+        ImGui_ImplOpenGL3_TexImageFonts(width, height, pixels);
+        bd->FontTextureWidth = width;
+        bd->FontTextureHeight = height;
+    }
+    else
+    {
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        GLint last_unpack_alignment = 4;
+        if (bd->FontTextureIsAlpha8) { GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment)); GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1)); }
+#endif
+        for (const ImTextureRect& r : atlas->TexUpdates)
+        {
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, width));
+            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, format, GL_UNSIGNED_BYTE, pixels + ((size_t)r.y * width + r.x) * bytes_per_pixel));
+#else
+            // Without GL_UNPACK_ROW_LENGTH we upload full rows
+            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, r.y, width, r.h, format, GL_UNSIGNED_BYTE, pixels + (size_t)r.y * width * bytes_per_pixel));
+#endif
+        }
+#ifdef GL_UNPACK_ROW_LENGTH
+        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TEXTURE_SWIZZLE
+        if (bd->FontTextureIsAlpha8)
+            GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment));
+#endif
+    }
+    atlas->TexUpdates.resize(0);
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+}
+
 void ImGui_ImplOpenGL3_DestroyFontsTexture()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -822,42 +971,72 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    precision mediump float;\n"
         "#endif\n"
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "varying vec2 Frag_UV;\n"
         "varying vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture2D(Texture, Frag_UV.st);\n"
+        "#ifndef GL_ES\n"
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(fwidth(tex.a) * 0.5, 0.001);\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "#endif\n"
+        "    gl_FragColor = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(fwidth(tex.a) * 0.5, 0.001);\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(fwidth(tex.a) * 0.5, 0.001);\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(fwidth(tex.a) * 0.5, 0.001);\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -911,6 +1090,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationSdfMode = glGetUniformLocation(bd->ShaderHandle, "SdfMode");
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
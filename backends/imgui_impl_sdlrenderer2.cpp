@@ -10,6 +10,7 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'SDL_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Font atlas partial texture updates (ImFontAtlas::TexUpdates[]), enabling ImFontAtlasFlags_IncrementalGlyphs.
 
 // You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -20,6 +21,7 @@
 // - Introduction, links and more at the top of imgui.cpp
 
 // CHANGELOG
+//  2024-05-06: Upload ImFontAtlas::TexUpdates[] regions with SDL_UpdateTexture() and recreate font texture when resized, enable ImGuiBackendFlags_RendererHasTexUpdates flag.
 //  2023-05-30: Renamed imgui_impl_sdlrenderer.h/.cpp to imgui_impl_sdlrenderer2.h/.cpp to accommodate for upcoming SDL3.
 //  2022-10-11: Using 'nullptr' instead of 'NULL' as per our switch to C++11.
 //  2021-12-21: Update SDL_RenderGeometryRaw() format to work with SDL 2.0.19.
@@ -49,6 +51,7 @@ struct ImGui_ImplSDLRenderer2_Data
 {
     SDL_Renderer*   SDLRenderer;
     SDL_Texture*    FontTexture;
+    int             FontTextureWidth, FontTextureHeight;
     ImGui_ImplSDLRenderer2_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
 
@@ -59,6 +62,9 @@ static ImGui_ImplSDLRenderer2_Data* ImGui_ImplSDLRenderer2_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplSDLRenderer2_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
 }
 
+// Forward Declarations
+static SDL_Texture* ImGui_ImplSDLRenderer2_UpdateFontsTexture();
+
 // Functions
 bool ImGui_ImplSDLRenderer2_Init(SDL_Renderer* renderer)
 {
@@ -71,6 +77,7 @@ bool ImGui_ImplSDLRenderer2_Init(SDL_Renderer* renderer)
     io.BackendRendererUserData = (void*)bd;
     io.BackendRendererName = "imgui_impl_sdlrenderer2";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // We can upload ImFontAtlas::TexUpdates[], allowing for incremental glyphs rasterization.
 
     bd->SDLRenderer = renderer;
 
@@ -87,7 +94,7 @@ void ImGui_ImplSDLRenderer2_Shutdown()
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTexUpdates);
     IM_DELETE(bd);
 }
 
@@ -130,6 +137,12 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data)
 	if (fb_width == 0 || fb_height == 0)
 		return;
 
+    // Upload modified regions of the font atlas (e.g. ImFontAtlasFlags_IncrementalGlyphs)
+    // If the atlas was resized the texture is recreated: draw commands still refer to the previous one, which we release after rendering.
+    SDL_Texture* prev_font_texture = nullptr;
+    if (bd->FontTexture && ImGui::GetIO().Fonts->TexUpdates.Size > 0)
+        prev_font_texture = ImGui_ImplSDLRenderer2_UpdateFontsTexture();
+
     // Backup SDL_Renderer state that will be modified to restore it afterwards
     struct BackupSDLRendererState
     {
@@ -191,6 +204,8 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data)
 
                 // Bind texture, Draw
 				SDL_Texture* tex = (SDL_Texture*)pcmd->GetTexID();
+                if (prev_font_texture != nullptr && tex == prev_font_texture)
+                    tex = bd->FontTexture;
                 SDL_RenderGeometryRaw(bd->SDLRenderer, tex,
                     xy, (int)sizeof(ImDrawVert),
                     color, (int)sizeof(ImDrawVert),
@@ -204,6 +219,9 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data)
     // Restore modified SDL_Renderer state
     SDL_RenderSetViewport(bd->SDLRenderer, &old.Viewport);
     SDL_RenderSetClipRect(bd->SDLRenderer, old.ClipEnabled ? &old.ClipRect : nullptr);
+
+    if (prev_font_texture != nullptr)
+        SDL_DestroyTexture(prev_font_texture);
 }
 
 // Called by Init/NewFrame/Shutdown
@@ -215,7 +233,7 @@ bool ImGui_ImplSDLRenderer2_CreateFontsTexture()
     // Build texture atlas
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because SDL_Renderer has no single channel texture format that we could sample as (1,1,1,A).
 
     // Upload texture to graphics system
     // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
@@ -228,13 +246,47 @@ bool ImGui_ImplSDLRenderer2_CreateFontsTexture()
     SDL_UpdateTexture(bd->FontTexture, nullptr, pixels, 4 * width);
     SDL_SetTextureBlendMode(bd->FontTexture, SDL_BLENDMODE_BLEND);
     SDL_SetTextureScaleMode(bd->FontTexture, SDL_ScaleModeLinear);
+    bd->FontTextureWidth = width;
+    bd->FontTextureHeight = height;
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
+    io.Fonts->TexUpdates.resize(0);
 
     return true;
 }
 
+// Upload ImFontAtlas::TexUpdates[] regions. Called by ImGui_ImplSDLRenderer2_RenderDrawData().
+// SDL textures can't be resized: when the atlas grew, a new texture is created and the previous one is returned for the caller to destroy.
+static SDL_Texture* ImGui_ImplSDLRenderer2_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImGui_ImplSDLRenderer2_Data* bd = ImGui_ImplSDLRenderer2_GetBackendData();
+
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    SDL_Texture* prev_font_texture = nullptr;
+    if (width != bd->FontTextureWidth || height != bd->FontTextureHeight)
+    {
+        prev_font_texture = bd->FontTexture;
+        if (!ImGui_ImplSDLRenderer2_CreateFontsTexture())
+        {
+            bd->FontTexture = prev_font_texture; // Keep using the previous texture
+            return nullptr;
+        }
+        return prev_font_texture;
+    }
+    for (const ImTextureRect& r : atlas->TexUpdates)
+    {
+        SDL_Rect rect = { r.x, r.y, r.w, r.h };
+        SDL_UpdateTexture(bd->FontTexture, &rect, pixels + ((size_t)r.y * width + r.x) * 4, 4 * width);
+    }
+    atlas->TexUpdates.resize(0);
+    return nullptr;
+}
+
 void ImGui_ImplSDLRenderer2_DestroyFontsTexture()
 {
     ImGuiIO& io = ImGui::GetIO();
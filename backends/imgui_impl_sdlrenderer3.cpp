@@ -10,6 +10,7 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'SDL_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Font atlas partial texture updates (ImFontAtlas::TexUpdates[]), enabling ImFontAtlasFlags_IncrementalGlyphs.
 
 // You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -20,6 +21,7 @@
 // - Introduction, links and more at the top of imgui.cpp
 
 // CHANGELOG
+//  2024-05-06: Upload ImFontAtlas::TexUpdates[] regions with SDL_UpdateTexture() and recreate font texture when resized, enable ImGuiBackendFlags_RendererHasTexUpdates flag.
 //  2024-02-12: Amend to query SDL_RenderViewportSet() and restore viewport accordingly.
 //  2023-05-30: Initial version.
 
@@ -45,6 +47,7 @@ struct ImGui_ImplSDLRenderer3_Data
 {
     SDL_Renderer*   SDLRenderer;
     SDL_Texture*    FontTexture;
+    int             FontTextureWidth, FontTextureHeight;
     ImGui_ImplSDLRenderer3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
 
@@ -55,6 +58,9 @@ static ImGui_ImplSDLRenderer3_Data* ImGui_ImplSDLRenderer3_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplSDLRenderer3_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
 }
 
+// Forward Declarations
+static SDL_Texture* ImGui_ImplSDLRenderer3_UpdateFontsTexture();
+
 // Functions
 bool ImGui_ImplSDLRenderer3_Init(SDL_Renderer* renderer)
 {
@@ -67,6 +73,7 @@ bool ImGui_ImplSDLRenderer3_Init(SDL_Renderer* renderer)
     io.BackendRendererUserData = (void*)bd;
     io.BackendRendererName = "imgui_impl_sdlrenderer3";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // We can upload ImFontAtlas::TexUpdates[], allowing for incremental glyphs rasterization.
 
     bd->SDLRenderer = renderer;
 
@@ -83,7 +90,7 @@ void ImGui_ImplSDLRenderer3_Shutdown()
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTexUpdates);
     IM_DELETE(bd);
 }
 
@@ -126,6 +133,12 @@ void ImGui_ImplSDLRenderer3_RenderDrawData(ImDrawData* draw_data)
 	if (fb_width == 0 || fb_height == 0)
 		return;
 
+    // Upload modified regions of the font atlas (e.g. ImFontAtlasFlags_IncrementalGlyphs)
+    // If the atlas was resized the texture is recreated: draw commands still refer to the previous one, which we release after rendering.
+    SDL_Texture* prev_font_texture = nullptr;
+    if (bd->FontTexture && ImGui::GetIO().Fonts->TexUpdates.Size > 0)
+        prev_font_texture = ImGui_ImplSDLRenderer3_UpdateFontsTexture();
+
     // Backup SDL_Renderer state that will be modified to restore it afterwards
     struct BackupSDLRendererState
     {
@@ -185,6 +198,8 @@ void ImGui_ImplSDLRenderer3_RenderDrawData(ImDrawData* draw_data)
 
                 // Bind texture, Draw
 				SDL_Texture* tex = (SDL_Texture*)pcmd->GetTexID();
+                if (prev_font_texture != nullptr && tex == prev_font_texture)
+                    tex = bd->FontTexture;
                 SDL_RenderGeometryRaw(bd->SDLRenderer, tex,
                     xy, (int)sizeof(ImDrawVert),
                     color, (int)sizeof(ImDrawVert),
@@ -198,6 +213,9 @@ void ImGui_ImplSDLRenderer3_RenderDrawData(ImDrawData* draw_data)
     // Restore modified SDL_Renderer state
     SDL_SetRenderViewport(bd->SDLRenderer, old.ViewportEnabled ? &old.Viewport : nullptr);
     SDL_SetRenderClipRect(bd->SDLRenderer, old.ClipEnabled ? &old.ClipRect : nullptr);
+
+    if (prev_font_texture != nullptr)
+        SDL_DestroyTexture(prev_font_texture);
 }
 
 // Called by Init/NewFrame/Shutdown
@@ -209,7 +227,7 @@ bool ImGui_ImplSDLRenderer3_CreateFontsTexture()
     // Build texture atlas
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because SDL_Renderer has no single channel texture format that we could sample as (1,1,1,A).
 
     // Upload texture to graphics system
     // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
@@ -222,13 +240,47 @@ bool ImGui_ImplSDLRenderer3_CreateFontsTexture()
     SDL_UpdateTexture(bd->FontTexture, nullptr, pixels, 4 * width);
     SDL_SetTextureBlendMode(bd->FontTexture, SDL_BLENDMODE_BLEND);
     SDL_SetTextureScaleMode(bd->FontTexture, SDL_SCALEMODE_LINEAR);
+    bd->FontTextureWidth = width;
+    bd->FontTextureHeight = height;
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
+    io.Fonts->TexUpdates.resize(0);
 
     return true;
 }
 
+// Upload ImFontAtlas::TexUpdates[] regions. Called by ImGui_ImplSDLRenderer3_RenderDrawData().
+// SDL textures can't be resized: when the atlas grew, a new texture is created and the previous one is returned for the caller to destroy.
+static SDL_Texture* ImGui_ImplSDLRenderer3_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImGui_ImplSDLRenderer3_Data* bd = ImGui_ImplSDLRenderer3_GetBackendData();
+
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    SDL_Texture* prev_font_texture = nullptr;
+    if (width != bd->FontTextureWidth || height != bd->FontTextureHeight)
+    {
+        prev_font_texture = bd->FontTexture;
+        if (!ImGui_ImplSDLRenderer3_CreateFontsTexture())
+        {
+            bd->FontTexture = prev_font_texture; // Keep using the previous texture
+            return nullptr;
+        }
+        return prev_font_texture;
+    }
+    for (const ImTextureRect& r : atlas->TexUpdates)
+    {
+        SDL_Rect rect = { r.x, r.y, r.w, r.h };
+        SDL_UpdateTexture(bd->FontTexture, &rect, pixels + ((size_t)r.y * width + r.x) * 4, 4 * width);
+    }
+    atlas->TexUpdates.resize(0);
+    return nullptr;
+}
+
 void ImGui_ImplSDLRenderer3_DestroyFontsTexture()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -4,6 +4,9 @@
 // Implemented features:
 //  [!] Renderer: User texture binding. Use 'VkDescriptorSet' as ImTextureID. Read the FAQ about ImTextureID! See https://github.com/ocornut/imgui/pull/914 for discussions.
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Font atlas partial texture updates (ImFontAtlas::TexUpdates[]), enabling ImFontAtlasFlags_IncrementalGlyphs.
+//  [X] Renderer: Single channel font texture (VK_FORMAT_R8_UNORM), unless ImFontAtlas::TexPixelsUseColors is set.
+//  [X] Renderer: Signed distance field fonts (ImFontAtlasFlags_SDF), when using the default pipeline.
 
 // Important: on 32-bit systems, user texture binding is only supported if your imconfig file has '#define ImTextureID ImU64'.
 // This is because we need ImTextureID to carry a 64-bit value and by default ImTextureID is defined as void*.
@@ -33,6 +36,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2024-05-06: Vulkan: Upload font atlas as a VK_FORMAT_R8_UNORM image sampled with a (1,1,1,R) image view swizzle, unless io.Fonts->TexPixelsUseColors is set. 4x less image memory.
+//  2024-05-06: Vulkan: Upload ImFontAtlas::TexUpdates[] regions with vkCmdCopyBufferToImage() (waiting on a fence for the previous upload, not on the queue) and resize font image when needed (keeping the same descriptor set), from ImGui_ImplVulkan_NewFrame() or from new ImGui_ImplVulkan_UpdateFontsTexture() function called after ImGui::Render(), enable ImGuiBackendFlags_RendererHasTexUpdates flag.
+//  2024-05-06: Vulkan: Added a second pipeline sampling the font atlas through a distance field function when ImFontAtlasFlags_SDF is set, enable ImGuiBackendFlags_RendererHasSdfFonts flag.
 //  2024-02-14: *BREAKING CHANGE*: Moved RenderPass parameter from ImGui_ImplVulkan_Init() function to ImGui_ImplVulkan_InitInfo structure. Not required when using dynamic rendering.
 //  2024-02-12: *BREAKING CHANGE*: Dynamic rendering now require filling PipelineRenderingCreateInfo structure.
 //  2024-01-19: Vulkan: Fixed vkAcquireNextImageKHR() validation errors in VulkanSDK 1.3.275 by allocating one extra semaphore than in-flight frames. (#7236)
@@ -177,8 +183,10 @@ static bool g_FunctionsLoaded = true;
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkQueueSubmit) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkQueueWaitIdle) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkResetCommandPool) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkResetFences) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkUnmapMemory) \
-    IMGUI_VULKAN_FUNC_MAP_MACRO(vkUpdateDescriptorSets)
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkUpdateDescriptorSets) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkWaitForFences)
 
 // Define function pointers
 #define IMGUI_VULKAN_FUNC_DEF(func) static PFN_##func func;
@@ -221,8 +229,10 @@ struct ImGui_ImplVulkan_Data
     VkDescriptorSetLayout       DescriptorSetLayout;
     VkPipelineLayout            PipelineLayout;
     VkPipeline                  Pipeline;
+    VkPipeline                  PipelineSdf;                // Same as Pipeline but using ShaderModuleFragSdf, used for font atlas draws when ImFontAtlasFlags_SDF is set
     VkShaderModule              ShaderModuleVert;
     VkShaderModule              ShaderModuleFrag;
+    VkShaderModule              ShaderModuleFragSdf;
 
     // Font data
     VkSampler                   FontSampler;
@@ -232,6 +242,12 @@ struct ImGui_ImplVulkan_Data
     VkDescriptorSet             FontDescriptorSet;
     VkCommandPool               FontCommandPool;
     VkCommandBuffer             FontCommandBuffer;
+    VkFence                     FontUploadFence;            // Signaled when the last ImGui_ImplVulkan_UpdateFontsTexture() upload completed
+    VkBuffer                    FontUploadBuffer;           // Reused by ImGui_ImplVulkan_UpdateFontsTexture(), grown as needed
+    VkDeviceMemory              FontUploadBufferMemory;
+    VkDeviceSize                FontUploadBufferSize;
+    int                         FontTextureWidth, FontTextureHeight;
+    bool                        FontTextureIsAlpha8;        // VK_FORMAT_R8_UNORM image, sampled as (1,1,1,R)
 
     // Render buffers for main window
     ImGui_ImplVulkan_WindowRenderBuffers MainWindowRenderBuffers;
@@ -352,6 +368,56 @@ static uint32_t __glsl_shader_frag_spv[] =
     0x00010038
 };
 
+// backends/vulkan/glsl_shader_sdf.frag, compiled with:
+// # glslangValidator -V -x -o glsl_shader_sdf.frag.u32 glsl_shader_sdf.frag
+/*
+#version 450 core
+layout(location = 0) out vec4 fColor;
+layout(set=0, binding=0) uniform sampler2D sTexture;
+layout(location = 0) in struct { vec4 Color; vec2 UV; } In;
+void main()
+{
+    vec4 tex = texture(sTexture, In.UV.st);
+    float w = max(fwidth(tex.a) * 0.5, 0.001);
+    tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);
+    fColor = In.Color * tex;
+}
+*/
+static uint32_t __glsl_shader_frag_sdf_spv[] =
+{
+    0x07230203,0x00010000,0x00080001,0x00000028,0x00000000,0x00020011,0x00000001,0x0006000b,
+    0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
+    0x0007000f,0x00000004,0x00000004,0x6e69616d,0x00000000,0x00000009,0x0000000d,0x00030010,
+    0x00000004,0x00000007,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000004,0x6e69616d,
+    0x00000000,0x00040005,0x00000009,0x6c6f4366,0x0000726f,0x00030005,0x0000000b,0x00000000,
+    0x00050006,0x0000000b,0x00000000,0x6f6c6f43,0x00000072,0x00040006,0x0000000b,0x00000001,
+    0x00005655,0x00030005,0x0000000d,0x00006e49,0x00050005,0x00000016,0x78655473,0x65727574,
+    0x00000000,0x00040047,0x00000009,0x0000001e,0x00000000,0x00040047,0x0000000d,0x0000001e,
+    0x00000000,0x00040047,0x00000016,0x00000022,0x00000000,0x00040047,0x00000016,0x00000021,
+    0x00000000,0x00020013,0x00000002,0x00030021,0x00000003,0x00000002,0x00030016,0x00000006,
+    0x00000020,0x00040017,0x00000007,0x00000006,0x00000004,0x00040020,0x00000008,0x00000003,
+    0x00000007,0x0004003b,0x00000008,0x00000009,0x00000003,0x00040017,0x0000000a,0x00000006,
+    0x00000002,0x0004001e,0x0000000b,0x00000007,0x0000000a,0x00040020,0x0000000c,0x00000001,
+    0x0000000b,0x0004003b,0x0000000c,0x0000000d,0x00000001,0x00040015,0x0000000e,0x00000020,
+    0x00000001,0x0004002b,0x0000000e,0x0000000f,0x00000000,0x00040020,0x00000010,0x00000001,
+    0x00000007,0x00090019,0x00000013,0x00000006,0x00000001,0x00000000,0x00000000,0x00000000,
+    0x00000001,0x00000000,0x0003001b,0x00000014,0x00000013,0x00040020,0x00000015,0x00000000,
+    0x00000014,0x0004003b,0x00000015,0x00000016,0x00000000,0x0004002b,0x0000000e,0x00000018,
+    0x00000001,0x00040020,0x00000019,0x00000001,0x0000000a,0x0004002b,0x00000006,0x0000001e,
+    0x3f000000,0x0004002b,0x00000006,0x0000001f,0x3a83126f,0x00050036,0x00000002,0x00000004,
+    0x00000000,0x00000003,0x000200f8,0x00000005,0x00050041,0x00000010,0x00000011,0x0000000d,
+    0x0000000f,0x0004003d,0x00000007,0x00000012,0x00000011,0x0004003d,0x00000014,0x00000017,
+    0x00000016,0x00050041,0x00000019,0x0000001a,0x0000000d,0x00000018,0x0004003d,0x0000000a,
+    0x0000001b,0x0000001a,0x00050057,0x00000007,0x0000001c,0x00000017,0x0000001b,0x00050051,
+    0x00000006,0x00000020,0x0000001c,0x00000003,0x000400d1,0x00000006,0x00000021,0x00000020,
+    0x00050085,0x00000006,0x00000022,0x00000021,0x0000001e,0x0007000c,0x00000006,0x00000023,
+    0x00000001,0x00000028,0x00000022,0x0000001f,0x00050083,0x00000006,0x00000024,0x0000001e,
+    0x00000023,0x00050081,0x00000006,0x00000025,0x0000001e,0x00000023,0x0008000c,0x00000006,
+    0x00000026,0x00000001,0x00000031,0x00000024,0x00000025,0x00000020,0x00060052,0x00000007,
+    0x00000027,0x00000026,0x0000001c,0x00000003,0x00050085,0x00000007,0x0000001d,0x00000012,
+    0x00000027,0x0003003e,0x00000009,0x0000001d,0x000100fd,0x00010038
+};
+
 //-----------------------------------------------------------------------------
 // FUNCTIONS
 //-----------------------------------------------------------------------------
@@ -484,6 +550,9 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     if (pipeline == VK_NULL_HANDLE)
         pipeline = bd->Pipeline;
 
+    // With ImFontAtlasFlags_SDF, font atlas draws use PipelineSdf. This is only done with our default pipeline: a custom pipeline is used as-is.
+    const bool font_is_sdf = (pipeline == bd->Pipeline) && (ImGui::GetIO().Fonts->Flags & ImFontAtlasFlags_SDF) != 0;
+
     // Allocate array to store enough vertex/index buffers
     ImGui_ImplVulkan_WindowRenderBuffers* wrb = &bd->MainWindowRenderBuffers;
     if (wrb->FrameRenderBuffers == nullptr)
@@ -537,6 +606,7 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
 
     // Setup desired Vulkan state
     ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
+    VkPipeline last_pipeline = pipeline;
 
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
@@ -557,7 +627,10 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
+                    last_pipeline = pipeline;
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -593,6 +666,14 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                 }
                 vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bd->PipelineLayout, 0, 1, desc_set, 0, nullptr);
 
+                // Bind distance field pipeline for font atlas draws (both pipelines share PipelineLayout, so push constants and descriptor sets stay bound)
+                VkPipeline cmd_pipeline = (font_is_sdf && desc_set[0] == bd->FontDescriptorSet) ? bd->PipelineSdf : pipeline;
+                if (cmd_pipeline != last_pipeline)
+                {
+                    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, cmd_pipeline);
+                    last_pipeline = cmd_pipeline;
+                }
+
                 // Draw
                 vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
             }
@@ -612,6 +693,67 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 }
 
+// Create font image + view. Descriptor set is created/updated by caller.
+static void ImGui_ImplVulkan_CreateFontImage(int width, int height)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    VkResult err;
+
+    // Create the Image:
+    {
+        VkImageCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        info.imageType = VK_IMAGE_TYPE_2D;
+        info.format = bd->FontTextureIsAlpha8 ? VK_FORMAT_R8_UNORM : VK_FORMAT_R8G8B8A8_UNORM;
+        info.extent.width = width;
+        info.extent.height = height;
+        info.extent.depth = 1;
+        info.mipLevels = 1;
+        info.arrayLayers = 1;
+        info.samples = VK_SAMPLE_COUNT_1_BIT;
+        info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        err = vkCreateImage(v->Device, &info, v->Allocator, &bd->FontImage);
+        check_vk_result(err);
+        VkMemoryRequirements req;
+        vkGetImageMemoryRequirements(v->Device, bd->FontImage, &req);
+        VkMemoryAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = IM_MAX(v->MinAllocationSize, req.size);
+        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, req.memoryTypeBits);
+        err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &bd->FontMemory);
+        check_vk_result(err);
+        err = vkBindImageMemory(v->Device, bd->FontImage, bd->FontMemory, 0);
+        check_vk_result(err);
+    }
+
+    // Create the Image View:
+    {
+        VkImageViewCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        info.image = bd->FontImage;
+        info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        info.format = bd->FontTextureIsAlpha8 ? VK_FORMAT_R8_UNORM : VK_FORMAT_R8G8B8A8_UNORM;
+        if (bd->FontTextureIsAlpha8)
+        {
+            info.components.r = VK_COMPONENT_SWIZZLE_ONE;
+            info.components.g = VK_COMPONENT_SWIZZLE_ONE;
+            info.components.b = VK_COMPONENT_SWIZZLE_ONE;
+            info.components.a = VK_COMPONENT_SWIZZLE_R;
+        }
+        info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        info.subresourceRange.levelCount = 1;
+        info.subresourceRange.layerCount = 1;
+        err = vkCreateImageView(v->Device, &info, v->Allocator, &bd->FontView);
+        check_vk_result(err);
+    }
+    bd->FontTextureWidth = width;
+    bd->FontTextureHeight = height;
+}
+
 bool ImGui_ImplVulkan_CreateFontsTexture()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -658,52 +800,15 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
 
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
-    size_t upload_size = width * height * 4 * sizeof(char);
-
-    // Create the Image:
-    {
-        VkImageCreateInfo info = {};
-        info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        info.imageType = VK_IMAGE_TYPE_2D;
-        info.format = VK_FORMAT_R8G8B8A8_UNORM;
-        info.extent.width = width;
-        info.extent.height = height;
-        info.extent.depth = 1;
-        info.mipLevels = 1;
-        info.arrayLayers = 1;
-        info.samples = VK_SAMPLE_COUNT_1_BIT;
-        info.tiling = VK_IMAGE_TILING_OPTIMAL;
-        info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        err = vkCreateImage(v->Device, &info, v->Allocator, &bd->FontImage);
-        check_vk_result(err);
-        VkMemoryRequirements req;
-        vkGetImageMemoryRequirements(v->Device, bd->FontImage, &req);
-        VkMemoryAllocateInfo alloc_info = {};
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = IM_MAX(v->MinAllocationSize, req.size);
-        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, req.memoryTypeBits);
-        err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &bd->FontMemory);
-        check_vk_result(err);
-        err = vkBindImageMemory(v->Device, bd->FontImage, bd->FontMemory, 0);
-        check_vk_result(err);
-    }
+    bd->FontTextureIsAlpha8 = !io.Fonts->TexPixelsUseColors; // Single channel unless user or FreeType rendered colored pixels
+    if (bd->FontTextureIsAlpha8)
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    else
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    const size_t bytes_per_pixel = bd->FontTextureIsAlpha8 ? 1 : 4;
+    size_t upload_size = width * height * bytes_per_pixel * sizeof(char);
 
-    // Create the Image View:
-    {
-        VkImageViewCreateInfo info = {};
-        info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        info.image = bd->FontImage;
-        info.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        info.format = VK_FORMAT_R8G8B8A8_UNORM;
-        info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        info.subresourceRange.levelCount = 1;
-        info.subresourceRange.layerCount = 1;
-        err = vkCreateImageView(v->Device, &info, v->Allocator, &bd->FontView);
-        check_vk_result(err);
-    }
+    ImGui_ImplVulkan_CreateFontImage(width, height);
 
     // Create the Descriptor Set:
     bd->FontDescriptorSet = (VkDescriptorSet)ImGui_ImplVulkan_AddTexture(bd->FontSampler, bd->FontView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
@@ -787,6 +892,7 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)bd->FontDescriptorSet);
+    io.Fonts->TexUpdates.resize(0);
 
     // End command buffer
     VkSubmitInfo end_info = {};
@@ -807,6 +913,180 @@ bool ImGui_ImplVulkan_CreateFontsTexture()
     return true;
 }
 
+// Upload ImFontAtlas::TexUpdates[] regions (e.g. ImFontAtlasFlags_IncrementalGlyphs). Called by ImGui_ImplVulkan_NewFrame(), or by user code after ImGui::Render().
+// If the atlas was resized, the image is recreated and our descriptor set updated to point to it, as ImTextureID may already be referenced by draw commands.
+// Updating the descriptor set invalidates command buffers it is bound in, so this must not be called while recording one using the font texture.
+void ImGui_ImplVulkan_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    VkResult err;
+    if (bd->FontDescriptorSet == VK_NULL_HANDLE || atlas->TexUpdates.Size == 0)
+        return;
+
+    unsigned char* pixels;
+    int width, height;
+    if (bd->FontTextureIsAlpha8)
+        atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    else
+        atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    const size_t bytes_per_pixel = bd->FontTextureIsAlpha8 ? 1 : 4;
+
+    // Wait for our previous upload to complete before reusing its command buffer and upload buffer.
+    // Previous frames sampling the image were submitted to the same queue: the copy is ordered after them by the pipeline barrier below.
+    if (bd->FontUploadFence == VK_NULL_HANDLE)
+    {
+        VkFenceCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        err = vkCreateFence(v->Device, &info, v->Allocator, &bd->FontUploadFence);
+        check_vk_result(err);
+    }
+    err = vkWaitForFences(v->Device, 1, &bd->FontUploadFence, VK_TRUE, UINT64_MAX);
+    check_vk_result(err);
+
+    const bool resize = (width != bd->FontTextureWidth || height != bd->FontTextureHeight);
+    if (resize)
+    {
+        // Submitted frames may still be sampling the old image through our descriptor set (only happens when the atlas grows)
+        err = vkQueueWaitIdle(v->Queue);
+        check_vk_result(err);
+
+        vkDestroyImageView(v->Device, bd->FontView, v->Allocator);
+        vkDestroyImage(v->Device, bd->FontImage, v->Allocator);
+        vkFreeMemory(v->Device, bd->FontMemory, v->Allocator);
+        ImGui_ImplVulkan_CreateFontImage(width, height);
+
+        VkDescriptorImageInfo desc_image[1] = {};
+        desc_image[0].sampler = bd->FontSampler;
+        desc_image[0].imageView = bd->FontView;
+        desc_image[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        VkWriteDescriptorSet write_desc[1] = {};
+        write_desc[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write_desc[0].dstSet = bd->FontDescriptorSet;
+        write_desc[0].descriptorCount = 1;
+        write_desc[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write_desc[0].pImageInfo = desc_image;
+        vkUpdateDescriptorSets(v->Device, 1, write_desc, 0, nullptr);
+    }
+
+    // Regions to upload, packed one after the other in the upload buffer.
+    // Each region starts on a 4 bytes boundary, as required for VkBufferImageCopy::bufferOffset (single channel rows are tightly packed).
+    const VkDeviceSize region_alignment = 4;
+    ImVector<ImTextureRect> rects;
+    if (resize)
+    {
+        ImTextureRect full_rect = { 0, 0, (unsigned short)width, (unsigned short)height };
+        rects.push_back(full_rect);
+    }
+    else
+    {
+        rects = atlas->TexUpdates;
+    }
+    VkDeviceSize upload_size = 0;
+    for (const ImTextureRect& r : rects)
+        upload_size = AlignBufferSize(upload_size, region_alignment) + (VkDeviceSize)r.w * r.h * bytes_per_pixel;
+
+    // Create or grow the Upload Buffer:
+    if (bd->FontUploadBuffer == VK_NULL_HANDLE || bd->FontUploadBufferSize < upload_size)
+        CreateOrResizeBuffer(bd->FontUploadBuffer, bd->FontUploadBufferMemory, bd->FontUploadBufferSize, (size_t)upload_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    VkDeviceMemory upload_buffer_memory = bd->FontUploadBufferMemory;
+    VkBuffer upload_buffer = bd->FontUploadBuffer;
+
+    // Upload to Buffer:
+    ImVector<VkBufferImageCopy> regions;
+    regions.resize(rects.Size);
+    {
+        char* map = nullptr;
+        err = vkMapMemory(v->Device, upload_buffer_memory, 0, upload_size, 0, (void**)(&map));
+        check_vk_result(err);
+        VkDeviceSize offset = 0;
+        for (int n = 0; n < rects.Size; n++)
+        {
+            const ImTextureRect& r = rects[n];
+            offset = AlignBufferSize(offset, region_alignment);
+            for (int y = 0; y < r.h; y++)
+                memcpy(map + (size_t)offset + (size_t)y * r.w * bytes_per_pixel, pixels + ((size_t)(r.y + y) * width + r.x) * bytes_per_pixel, (size_t)r.w * bytes_per_pixel);
+            VkBufferImageCopy& region = regions[n];
+            memset(&region, 0, sizeof(region));
+            region.bufferOffset = offset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset.x = r.x;
+            region.imageOffset.y = r.y;
+            region.imageExtent.width = r.w;
+            region.imageExtent.height = r.h;
+            region.imageExtent.depth = 1;
+            offset += (VkDeviceSize)r.w * r.h * bytes_per_pixel;
+        }
+        VkMappedMemoryRange range[1] = {};
+        range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range[0].memory = upload_buffer_memory;
+        range[0].size = VK_WHOLE_SIZE;
+        err = vkFlushMappedMemoryRanges(v->Device, 1, range);
+        check_vk_result(err);
+        vkUnmapMemory(v->Device, upload_buffer_memory);
+    }
+
+    // Start command buffer
+    {
+        err = vkResetCommandPool(v->Device, bd->FontCommandPool, 0);
+        check_vk_result(err);
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        err = vkBeginCommandBuffer(bd->FontCommandBuffer, &begin_info);
+        check_vk_result(err);
+    }
+
+    // Copy to Image (existing contents are preserved unless the image was just created):
+    {
+        VkImageMemoryBarrier copy_barrier[1] = {};
+        copy_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        copy_barrier[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        copy_barrier[0].oldLayout = resize ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        copy_barrier[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        copy_barrier[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        copy_barrier[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        copy_barrier[0].image = bd->FontImage;
+        copy_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy_barrier[0].subresourceRange.levelCount = 1;
+        copy_barrier[0].subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(bd->FontCommandBuffer, VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, copy_barrier);
+
+        vkCmdCopyBufferToImage(bd->FontCommandBuffer, upload_buffer, bd->FontImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)regions.Size, regions.Data);
+
+        VkImageMemoryBarrier use_barrier[1] = {};
+        use_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        use_barrier[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        use_barrier[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        use_barrier[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        use_barrier[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        use_barrier[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        use_barrier[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        use_barrier[0].image = bd->FontImage;
+        use_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        use_barrier[0].subresourceRange.levelCount = 1;
+        use_barrier[0].subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(bd->FontCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, use_barrier);
+    }
+
+    // End command buffer
+    VkSubmitInfo end_info = {};
+    end_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    end_info.commandBufferCount = 1;
+    end_info.pCommandBuffers = &bd->FontCommandBuffer;
+    err = vkEndCommandBuffer(bd->FontCommandBuffer);
+    check_vk_result(err);
+    err = vkResetFences(v->Device, 1, &bd->FontUploadFence);
+    check_vk_result(err);
+    err = vkQueueSubmit(v->Queue, 1, &end_info, bd->FontUploadFence);
+    check_vk_result(err);
+
+    atlas->TexUpdates.resize(0);
+}
+
 // You probably never need to call this, as it is called by ImGui_ImplVulkan_CreateFontsTexture() and ImGui_ImplVulkan_Shutdown().
 void ImGui_ImplVulkan_DestroyFontsTexture()
 {
@@ -848,9 +1128,18 @@ static void ImGui_ImplVulkan_CreateShaderModules(VkDevice device, const VkAlloca
         VkResult err = vkCreateShaderModule(device, &frag_info, allocator, &bd->ShaderModuleFrag);
         check_vk_result(err);
     }
+    if (bd->ShaderModuleFragSdf == VK_NULL_HANDLE)
+    {
+        VkShaderModuleCreateInfo frag_info = {};
+        frag_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        frag_info.codeSize = sizeof(__glsl_shader_frag_sdf_spv);
+        frag_info.pCode = (uint32_t*)__glsl_shader_frag_sdf_spv;
+        VkResult err = vkCreateShaderModule(device, &frag_info, allocator, &bd->ShaderModuleFragSdf);
+        check_vk_result(err);
+    }
 }
 
-static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipelineCache pipelineCache, VkRenderPass renderPass, VkSampleCountFlagBits MSAASamples, VkPipeline* pipeline, uint32_t subpass)
+static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationCallbacks* allocator, VkPipelineCache pipelineCache, VkRenderPass renderPass, VkSampleCountFlagBits MSAASamples, VkPipeline* pipeline, uint32_t subpass, bool sdf = false)
 {
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_CreateShaderModules(device, allocator);
@@ -862,7 +1151,7 @@ static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationC
     stage[0].pName = "main";
     stage[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     stage[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    stage[1].module = bd->ShaderModuleFrag;
+    stage[1].module = sdf ? bd->ShaderModuleFragSdf : bd->ShaderModuleFrag;
     stage[1].pName = "main";
 
     VkVertexInputBindingDescription binding_desc[1] = {};
@@ -1022,6 +1311,7 @@ bool ImGui_ImplVulkan_CreateDeviceObjects()
     }
 
     ImGui_ImplVulkan_CreatePipeline(v->Device, v->Allocator, v->PipelineCache, v->RenderPass, v->MSAASamples, &bd->Pipeline, v->Subpass);
+    ImGui_ImplVulkan_CreatePipeline(v->Device, v->Allocator, v->PipelineCache, v->RenderPass, v->MSAASamples, &bd->PipelineSdf, v->Subpass, true);
 
     return true;
 }
@@ -1031,16 +1321,21 @@ void    ImGui_ImplVulkan_DestroyDeviceObjects()
     ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
     ImGui_ImplVulkan_DestroyWindowRenderBuffers(v->Device, &bd->MainWindowRenderBuffers, v->Allocator);
+    if (bd->FontUploadFence)      { vkWaitForFences(v->Device, 1, &bd->FontUploadFence, VK_TRUE, UINT64_MAX); vkDestroyFence(v->Device, bd->FontUploadFence, v->Allocator); bd->FontUploadFence = VK_NULL_HANDLE; }
     ImGui_ImplVulkan_DestroyFontsTexture();
 
+    if (bd->FontUploadBuffer)     { vkDestroyBuffer(v->Device, bd->FontUploadBuffer, v->Allocator); bd->FontUploadBuffer = VK_NULL_HANDLE; }
+    if (bd->FontUploadBufferMemory) { vkFreeMemory(v->Device, bd->FontUploadBufferMemory, v->Allocator); bd->FontUploadBufferMemory = VK_NULL_HANDLE; bd->FontUploadBufferSize = 0; }
     if (bd->FontCommandBuffer)    { vkFreeCommandBuffers(v->Device, bd->FontCommandPool, 1, &bd->FontCommandBuffer); bd->FontCommandBuffer = VK_NULL_HANDLE; }
     if (bd->FontCommandPool)      { vkDestroyCommandPool(v->Device, bd->FontCommandPool, v->Allocator); bd->FontCommandPool = VK_NULL_HANDLE; }
     if (bd->ShaderModuleVert)     { vkDestroyShaderModule(v->Device, bd->ShaderModuleVert, v->Allocator); bd->ShaderModuleVert = VK_NULL_HANDLE; }
     if (bd->ShaderModuleFrag)     { vkDestroyShaderModule(v->Device, bd->ShaderModuleFrag, v->Allocator); bd->ShaderModuleFrag = VK_NULL_HANDLE; }
+    if (bd->ShaderModuleFragSdf)  { vkDestroyShaderModule(v->Device, bd->ShaderModuleFragSdf, v->Allocator); bd->ShaderModuleFragSdf = VK_NULL_HANDLE; }
     if (bd->FontSampler)          { vkDestroySampler(v->Device, bd->FontSampler, v->Allocator); bd->FontSampler = VK_NULL_HANDLE; }
     if (bd->DescriptorSetLayout)  { vkDestroyDescriptorSetLayout(v->Device, bd->DescriptorSetLayout, v->Allocator); bd->DescriptorSetLayout = VK_NULL_HANDLE; }
     if (bd->PipelineLayout)       { vkDestroyPipelineLayout(v->Device, bd->PipelineLayout, v->Allocator); bd->PipelineLayout = VK_NULL_HANDLE; }
     if (bd->Pipeline)             { vkDestroyPipeline(v->Device, bd->Pipeline, v->Allocator); bd->Pipeline = VK_NULL_HANDLE; }
+    if (bd->PipelineSdf)          { vkDestroyPipeline(v->Device, bd->PipelineSdf, v->Allocator); bd->PipelineSdf = VK_NULL_HANDLE; }
 }
 
 bool    ImGui_ImplVulkan_LoadFunctions(PFN_vkVoidFunction(*loader_func)(const char* function_name, void* user_data), void* user_data)
@@ -1097,6 +1392,8 @@ bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info)
     io.BackendRendererUserData = (void*)bd;
     io.BackendRendererName = "imgui_impl_vulkan";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfFonts;   // We can apply a distance field function to the font atlas, allowing for ImFontAtlasFlags_SDF. Only with our default pipeline: a custom pipeline passed to ImGui_ImplVulkan_RenderDrawData() needs its own SDF shader.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // We can upload ImFontAtlas::TexUpdates[], allowing for incremental glyphs rasterization.
 
     IM_ASSERT(info->Instance != VK_NULL_HANDLE);
     IM_ASSERT(info->PhysicalDevice != VK_NULL_HANDLE);
@@ -1124,7 +1421,7 @@ void ImGui_ImplVulkan_Shutdown()
     ImGui_ImplVulkan_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTexUpdates | ImGuiBackendFlags_RendererHasSdfFonts);
     IM_DELETE(bd);
 }
 
@@ -1135,6 +1432,8 @@ void ImGui_ImplVulkan_NewFrame()
 
     if (!bd->FontDescriptorSet)
         ImGui_ImplVulkan_CreateFontsTexture();
+    else
+        ImGui_ImplVulkan_UpdateFontsTexture(); // In case user code didn't call it after last ImGui::Render(), which avoids a frame of latency
 }
 
 void ImGui_ImplVulkan_SetMinImageCount(uint32_t min_image_count)
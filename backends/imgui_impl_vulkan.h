@@ -4,6 +4,9 @@
 // Implemented features:
 //  [!] Renderer: User texture binding. Use 'VkDescriptorSet' as ImTextureID. Read the FAQ about ImTextureID! See https://github.com/ocornut/imgui/pull/914 for discussions.
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Font atlas partial texture updates (ImFontAtlas::TexUpdates[]), enabling ImFontAtlasFlags_IncrementalGlyphs.
+//  [X] Renderer: Single channel font texture (VK_FORMAT_R8_UNORM), unless ImFontAtlas::TexPixelsUseColors is set.
+//  [X] Renderer: Signed distance field fonts (ImFontAtlasFlags_SDF), when using the default pipeline.
 
 // Important: on 32-bit systems, user texture binding is only supported if your imconfig file has '#define ImTextureID ImU64'.
 // See imgui_impl_vulkan.cpp file for details.
@@ -95,9 +98,10 @@ struct ImGui_ImplVulkan_InitInfo
 IMGUI_IMPL_API bool         ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info);
 IMGUI_IMPL_API void         ImGui_ImplVulkan_Shutdown();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_NewFrame();
-IMGUI_IMPL_API void         ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline = VK_NULL_HANDLE);
+IMGUI_IMPL_API void         ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline = VK_NULL_HANDLE); // A custom 'pipeline' is used as-is for all draws: it won't render ImFontAtlasFlags_SDF fonts unless its fragment shader applies the distance field function (see ImFontAtlasSdfCoverage()).
 IMGUI_IMPL_API bool         ImGui_ImplVulkan_CreateFontsTexture();
 IMGUI_IMPL_API void         ImGui_ImplVulkan_DestroyFontsTexture();
+IMGUI_IMPL_API void         ImGui_ImplVulkan_UpdateFontsTexture();                      // Upload io.Fonts->TexUpdates[]. Call after ImGui::Render() and before recording commands using the font texture, otherwise done in ImGui_ImplVulkan_NewFrame() with a frame of latency.
 IMGUI_IMPL_API void         ImGui_ImplVulkan_SetMinImageCount(uint32_t min_image_count); // To override MinImageCount after initialization (e.g. if swap chain is recreated)
 
 // Register a texture (VkDescriptorSet == ImTextureID)
@@ -0,0 +1,18 @@
+#version 450 core
+layout(location = 0) out vec4 fColor;
+
+layout(set=0, binding=0) uniform sampler2D sTexture;
+
+layout(location = 0) in struct {
+    vec4 Color;
+    vec2 UV;
+} In;
+
+void main()
+{
+    // Distance field font atlas (ImFontAtlasFlags_SDF): alpha is 0.5 on glyph outlines, antialias over ~1 screen pixel.
+    vec4 tex = texture(sTexture, In.UV.st);
+    float w = max(fwidth(tex.a) * 0.5, 0.001);
+    tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);
+    fColor = In.Color * tex;
+}
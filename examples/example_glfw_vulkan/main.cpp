@@ -532,6 +532,7 @@ int main(int, char**)
 
         // Rendering
         ImGui::Render();
+        ImGui_ImplVulkan_UpdateFontsTexture(); // Upload glyphs added to the font atlas this frame, before recording our command buffer
         ImDrawData* draw_data = ImGui::GetDrawData();
         const bool is_minimized = (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f);
         if (!is_minimized)
@@ -71,7 +71,7 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
-// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex, ImGuiTextSizeCache
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -1317,9 +1317,12 @@ ImGuiIO::ImGuiIO()
     ConfigInputTrickleEventQueue = true;
     ConfigInputTextCursorBlink = true;
     ConfigInputTextEnterKeepActive = false;
+    ConfigInputTextUndoMemory = 1024 * 1024;
     ConfigDragClickToInputText = false;
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
+    ConfigWindowsOcclusionCulling = false;
+    ConfigTextSizeCacheSize = 0;
     ConfigMemoryCompactTimer = 60.0f;
     ConfigDebugBeginReturnValueOnce = false;
     ConfigDebugBeginReturnValueLoop = false;
@@ -2058,6 +2061,37 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
     return ~crc;
 }
 
+// 64-bit hash (MurmurHash64A by Austin Appleby, public domain), processing 8 bytes at a time.
+// Use when we cannot afford to compare original data to validate a match, so the 32-bit collision rate of ImHashData() is too high.
+// Result depends on endianness.
+ImU64 ImHashData64(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const ImU64 m = 0xC6A4A7935BD1E995ULL;
+    ImU64 h = seed ^ ((ImU64)data_size * m);
+    const unsigned char* data = (const unsigned char*)data_p;
+    for (; data_size >= 8; data_size -= 8, data += 8)
+    {
+        ImU64 k;
+        memcpy(&k, data, 8);
+        k *= m;
+        k ^= k >> 47;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    if (data_size > 0)
+    {
+        ImU64 k = 0;
+        memcpy(&k, data, data_size);
+        h ^= k;
+        h *= m;
+    }
+    h ^= h >> 47;
+    h *= m;
+    h ^= h >> 47;
+    return h;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -2654,7 +2688,7 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 }
 
 //-----------------------------------------------------------------------------
-// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex, ImGuiTextSizeCache
 //-----------------------------------------------------------------------------
 
 // On some platform vsnprintf() takes va_list by reference and modifies it.
@@ -2736,6 +2770,92 @@ void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
     EndOffset = ImMax(EndOffset, new_size);
 }
 
+static void TextSizeCacheLruUnlink(ImGuiTextSizeCache* cache, int n)
+{
+    ImGuiTextSizeCacheEntry* entry = &cache->Entries[n];
+    if (entry->LruPrev != -1) cache->Entries[entry->LruPrev].LruNext = entry->LruNext; else cache->LruHead = entry->LruNext;
+    if (entry->LruNext != -1) cache->Entries[entry->LruNext].LruPrev = entry->LruPrev; else cache->LruTail = entry->LruPrev;
+}
+
+static void TextSizeCacheLruPushFront(ImGuiTextSizeCache* cache, int n)
+{
+    ImGuiTextSizeCacheEntry* entry = &cache->Entries[n];
+    entry->LruPrev = -1;
+    entry->LruNext = cache->LruHead;
+    if (cache->LruHead != -1)
+        cache->Entries[cache->LruHead].LruPrev = n;
+    cache->LruHead = n;
+    if (cache->LruTail == -1)
+        cache->LruTail = n;
+}
+
+void ImGuiTextSizeCache::Clear()
+{
+    Entries.resize(0);
+    if (Buckets.Size > 0)
+        memset(Buckets.Data, 0xFF, (size_t)Buckets.size_in_bytes()); // Set all to -1
+    LruHead = LruTail = -1;
+}
+
+void ImGuiTextSizeCache::SetCapacity(int capacity)
+{
+    Entries.clear();
+    Buckets.clear();
+    Capacity = ImMax(capacity, 0);
+    if (Capacity > 0)
+    {
+        int buckets_count = 16;
+        while (buckets_count < Capacity)
+            buckets_count <<= 1;
+        Entries.reserve(Capacity);
+        Buckets.resize(buckets_count);
+    }
+    Clear();
+}
+
+const ImVec2* ImGuiTextSizeCache::Find(ImU64 key)
+{
+    for (int n = Buckets.Data[(int)(key & (ImU64)(Buckets.Size - 1))]; n != -1; n = Entries.Data[n].BucketNext)
+        if (Entries.Data[n].Key == key)
+        {
+            if (LruHead != n)
+            {
+                TextSizeCacheLruUnlink(this, n);
+                TextSizeCacheLruPushFront(this, n);
+            }
+            return &Entries.Data[n].Size;
+        }
+    return NULL;
+}
+
+void ImGuiTextSizeCache::Add(ImU64 key, const ImVec2& size)
+{
+    IM_ASSERT(Capacity > 0);
+    int n;
+    if (Entries.Size < Capacity)
+    {
+        n = Entries.Size;
+        Entries.resize(n + 1);
+    }
+    else
+    {
+        // Evict least recently used entry
+        n = LruTail;
+        TextSizeCacheLruUnlink(this, n);
+        int* p_bucket_n = &Buckets.Data[(int)(Entries.Data[n].Key & (ImU64)(Buckets.Size - 1))];
+        while (*p_bucket_n != n)
+            p_bucket_n = &Entries.Data[*p_bucket_n].BucketNext;
+        *p_bucket_n = Entries.Data[n].BucketNext;
+    }
+    int* p_bucket_head = &Buckets.Data[(int)(key & (ImU64)(Buckets.Size - 1))];
+    ImGuiTextSizeCacheEntry* entry = &Entries.Data[n];
+    entry->Key = key;
+    entry->Size = size;
+    entry->BucketNext = *p_bucket_head;
+    *p_bucket_head = n;
+    TextSizeCacheLruPushFront(this, n);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 //-----------------------------------------------------------------------------
@@ -2772,7 +2892,7 @@ static void ImGuiListClipper_SortAndFuseRanges(ImVector<ImGuiListClipperRange>&
     }
 }
 
-static void ImGuiListClipper_SeekCursorAndSetupPrevLine(float pos_y, float line_height)
+static void ImGuiListClipper_SeekCursorAndSetupPrevLine(float pos_y, float line_height, int rows_skipped = -1)
 {
     // Set cursor position and a few other things so that SetScrollHereY() and Columns() can work when seeking cursor.
     // FIXME: It is problematic that we have to do that here, because custom/equivalent end-user code would stumble on the same issue.
@@ -2791,7 +2911,7 @@ static void ImGuiListClipper_SeekCursorAndSetupPrevLine(float pos_y, float line_
         if (table->IsInsideRow)
             ImGui::TableEndRow(table);
         table->RowPosY2 = window->DC.CursorPos.y;
-        const int row_increase = (int)((off_y / line_height) + 0.5f);
+        const int row_increase = (rows_skipped >= 0) ? rows_skipped : (int)((off_y / line_height) + 0.5f);
         //table->CurrentRow += row_increase; // Can't do without fixing TableEndRow()
         table->RowBgColorCounter += row_increase;
     }
@@ -2802,10 +2922,94 @@ static void ImGuiListClipper_SeekCursorForItem(ImGuiListClipper* clipper, int it
     // StartPosY starts from ItemsFrozen hence the subtraction
     // Perform the add and multiply with double to allow seeking through larger ranges
     ImGuiListClipperData* data = (ImGuiListClipperData*)clipper->TempData;
+    if (ImGuiListClipperHeights* heights = data->Heights)
+    {
+        // Variable height: cursor is after item DisplayEnd-1, so we know how many rows are skipped
+        ImGuiWindow* window = clipper->Ctx->CurrentWindow;
+        float pos_y = (float)((double)clipper->StartPosY + data->LossynessOffset + heights->GetItemPos(item_n) - heights->GetItemPos(data->ItemsFrozen));
+        int rows_skipped = (pos_y > window->DC.CursorPos.y) ? ImMax(item_n - clipper->DisplayEnd, 0) : 0;
+        ImGuiListClipper_SeekCursorAndSetupPrevLine(pos_y, heights->GetItemHeight(ImMax(item_n - 1, 0)), rows_skipped);
+        return;
+    }
     float pos_y = (float)((double)clipper->StartPosY + data->LossynessOffset + (double)(item_n - data->ItemsFrozen) * clipper->ItemsHeight);
     ImGuiListClipper_SeekCursorAndSetupPrevLine(pos_y, clipper->ItemsHeight);
 }
 
+void ImGuiListClipperHeights::Resize(int items_count)
+{
+    const int old_count = Heights.Size;
+    Heights.resize(items_count, 0.0f);
+    TreeHeights.resize(items_count + 1, 0.0);
+    TreeMeasured.resize(items_count + 1, 0);
+    TreeHeights[0] = 0.0;
+    TreeMeasured[0] = 0;
+
+    // Append new (unmeasured) items: node k covers items (k - lowbit(k), k], all of which are before k, so we can fill it from prefix sums
+    for (int k = old_count + 1; k <= items_count; k++)
+    {
+        double sum_heights = 0.0;
+        int sum_measured = 0;
+        for (int j = k - 1; j > k - (k & -k); j -= (j & -j))
+        {
+            sum_heights += TreeHeights[j];
+            sum_measured += TreeMeasured[j];
+        }
+        TreeHeights[k] = sum_heights;
+        TreeMeasured[k] = sum_measured;
+    }
+}
+
+void ImGuiListClipperHeights::SetItemHeight(int item_n, float height)
+{
+    IM_ASSERT(item_n >= 0 && item_n < Heights.Size);
+    height = ImMax(height, 0.0f);
+    const double delta_height = (double)height - Heights[item_n];
+    const int delta_measured = (height > 0.0f ? 1 : 0) - (Heights[item_n] > 0.0f ? 1 : 0);
+    if (delta_height == 0.0 && delta_measured == 0)
+        return;
+    Heights[item_n] = height;
+    for (int k = item_n + 1; k <= Heights.Size; k += (k & -k))
+    {
+        TreeHeights[k] += delta_height;
+        TreeMeasured[k] += delta_measured;
+    }
+}
+
+double ImGuiListClipperHeights::GetItemPos(int item_n) const
+{
+    IM_ASSERT(item_n >= 0 && item_n <= Heights.Size);
+    double sum_heights = 0.0;
+    int sum_measured = 0;
+    for (int k = item_n; k > 0; k -= (k & -k))
+    {
+        sum_heights += TreeHeights[k];
+        sum_measured += TreeMeasured[k];
+    }
+    return sum_heights + (double)(item_n - sum_measured) * HeightEstimate;
+}
+
+int ImGuiListClipperHeights::FindItemAtPos(double pos) const
+{
+    // Descend the trees: each node we visit covers 'step' items following 'item_n'
+    const int items_count = Heights.Size;
+    int step = 1;
+    while (step * 2 <= items_count)
+        step *= 2;
+    int item_n = 0;
+    double item_pos = 0.0;
+    for (; step > 0; step >>= 1)
+        if (item_n + step <= items_count)
+        {
+            const double node_height = TreeHeights[item_n + step] + (double)(step - TreeMeasured[item_n + step]) * HeightEstimate;
+            if (item_pos + node_height <= pos)
+            {
+                item_n += step;
+                item_pos += node_height;
+            }
+        }
+    return ImClamp(item_n, 0, items_count - 1);
+}
+
 ImGuiListClipper::ImGuiListClipper()
 {
     memset(this, 0, sizeof(*this));
@@ -2844,6 +3048,42 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     TempData = data;
 }
 
+void ImGuiListClipper::BeginVariableHeight(ImGuiID id, int items_count, float items_height_estimate)
+{
+    IM_ASSERT(items_count >= 0 && items_count < INT_MAX && "Variable height mode needs to know the number of items.");
+    Begin(items_count, -1.0f);
+
+    ImGuiContext& g = *Ctx;
+    ImGuiListClipperHeights* heights = NULL;
+    for (ImGuiListClipperHeights* h : g.ClipperHeights)
+        if (h->ID == id)
+        {
+            heights = h;
+            break;
+        }
+    if (heights == NULL)
+    {
+        heights = IM_NEW(ImGuiListClipperHeights)();
+        heights->ID = id;
+        g.ClipperHeights.push_back(heights);
+    }
+    heights->LastTimeActive = (float)g.Time;
+    heights->Resize(items_count);
+    if (items_height_estimate > 0.0f)
+        heights->HeightEstimate = items_height_estimate;
+    ItemsHeight = (heights->HeightEstimate > 0.0f) ? heights->HeightEstimate : -1.0f; // Otherwise measure first item
+
+    ImGuiListClipperData* data = (ImGuiListClipperData*)TempData;
+    data->Heights = heights;
+}
+
+void ImGuiListClipper::SetItemHeight(int item_index, float item_height)
+{
+    ImGuiListClipperData* data = (ImGuiListClipperData*)TempData;
+    IM_ASSERT(data != NULL && data->Heights != NULL && "Only valid after BeginVariableHeight()!");
+    data->Heights->SetItemHeight(item_index, item_height);
+}
+
 void ImGuiListClipper::End()
 {
     if (ImGuiListClipperData* data = (ImGuiListClipperData*)TempData)
@@ -2854,6 +3094,16 @@ void ImGuiListClipper::End()
         if (ItemsCount >= 0 && ItemsCount < INT_MAX && DisplayStart >= 0)
             ImGuiListClipper_SeekCursorForItem(this, ItemsCount);
 
+        // Variable height: keep visible items in place when items above them changed height
+        if (data->ScrollAdjustY != 0.0f)
+        {
+            ImGuiWindow* window = g.CurrentWindow;
+            if (window->ScrollTarget.y < FLT_MAX)
+                window->ScrollTarget.y += data->ScrollAdjustY;
+            else
+                ImGui::SetScrollY(window, window->Scroll.y + data->ScrollAdjustY);
+        }
+
         // Restore temporary buffer and fix back pointers which may be invalidated when nesting
         IM_ASSERT(data->ListClipper == this);
         data->StepNo = data->Ranges.Size;
@@ -2887,6 +3137,22 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     if (table && table->IsInsideRow)
         ImGui::TableEndRow(table);
 
+    // Variable height: measure the item displayed by previous step
+    ImGuiListClipperHeights* heights = data->Heights;
+    if (heights && data->MeasureItem >= 0)
+    {
+        const float item_height = window->DC.CursorPos.y - data->MeasureStartPosY;
+        if (item_height > 0.0f)
+        {
+            if (heights->HeightEstimate <= 0.0f)
+                heights->HeightEstimate = item_height;
+            if (data->MeasureStartPosY < window->ClipRect.Min.y && window->ScrollMax.y > 0.0f)
+                data->ScrollAdjustY += item_height - heights->GetItemHeight(data->MeasureItem);
+            heights->SetItemHeight(data->MeasureItem, item_height);
+        }
+        data->MeasureItem = -1;
+    }
+
     // No items
     if (clipper->ItemsCount == 0 || GetSkipItemForListClipping())
         return false;
@@ -2904,8 +3170,9 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
 
     // Step 0: Let you process the first element (regardless of it being visible or not, so we can measure the element height)
     bool calc_clipping = false;
-    if (data->StepNo == 0)
+    if (data->StepNo == 0 && !data->StepZeroDone)
     {
+        data->StepZeroDone = true;
         clipper->StartPosY = window->DC.CursorPos.y;
         if (clipper->ItemsHeight <= 0.0f)
         {
@@ -2914,13 +3181,26 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
             clipper->DisplayStart = ImMax(data->Ranges[0].Min, data->ItemsFrozen);
             clipper->DisplayEnd = ImMin(data->Ranges[0].Max, clipper->ItemsCount);
             data->StepNo = 1;
+            if (heights)
+            {
+                data->MeasureItem = clipper->DisplayStart;
+                data->MeasureStartPosY = window->DC.CursorPos.y;
+            }
             return true;
         }
         calc_clipping = true;   // If on the first step with known item height, calculate clipping.
     }
 
     // Step 1: Let the clipper infer height from first range
-    if (clipper->ItemsHeight <= 0.0f)
+    if (clipper->ItemsHeight <= 0.0f && heights)
+    {
+        // Variable height: first item was measured at the top of this function
+        IM_ASSERT(data->StepNo == 1);
+        clipper->ItemsHeight = heights->HeightEstimate;
+        IM_ASSERT(clipper->ItemsHeight > 0.0f && "Unable to calculate item height! First item hasn't moved the cursor vertically!");
+        calc_clipping = true;
+    }
+    else if (clipper->ItemsHeight <= 0.0f)
     {
         IM_ASSERT(data->StepNo == 1);
         if (table)
@@ -2969,7 +3249,17 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
         // - Due to how Selectable extra padding they tend to be "unaligned" with exact unit in the item list,
         //   which with the flooring/ceiling tend to lead to 2 items instead of one being submitted.
         for (ImGuiListClipperRange& range : data->Ranges)
-            if (range.PosToIndexConvert)
+            if (range.PosToIndexConvert && heights)
+            {
+                // Variable height: lookup items at positions, relative to first unfrozen item
+                const double pos_offset = heights->GetItemPos(data->ItemsFrozen) - clipper->StartPosY - data->LossynessOffset;
+                const int m1 = heights->FindItemAtPos(range.Min + pos_offset);
+                const int m2 = heights->FindItemAtPos(range.Max + pos_offset) + 1;
+                range.Min = ImClamp(m1 + range.PosToIndexOffsetMin, already_submitted, clipper->ItemsCount - 1);
+                range.Max = ImClamp(m2 + range.PosToIndexOffsetMax, range.Min + 1, clipper->ItemsCount);
+                range.PosToIndexConvert = false;
+            }
+            else if (range.PosToIndexConvert)
             {
                 int m1 = (int)(((double)range.Min - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight);
                 int m2 = (int)((((double)range.Max - window->DC.CursorPos.y - data->LossynessOffset) / clipper->ItemsHeight) + 0.999999f);
@@ -2981,15 +3271,24 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
     }
 
     // Step 0+ (if item height is given in advance) or 1+: Display the next range in line.
+    // (Variable height: display one item at a time so we can measure it, only moving to next range when done)
     while (data->StepNo < data->Ranges.Size)
     {
-        clipper->DisplayStart = ImMax(data->Ranges[data->StepNo].Min, already_submitted);
-        clipper->DisplayEnd = ImMin(data->Ranges[data->StepNo].Max, clipper->ItemsCount);
-        if (clipper->DisplayStart > already_submitted) //-V1051
-            ImGuiListClipper_SeekCursorForItem(clipper, clipper->DisplayStart);
-        data->StepNo++;
+        const int display_start = ImMax(data->Ranges[data->StepNo].Min, already_submitted);
+        const int range_end = ImMin(data->Ranges[data->StepNo].Max, clipper->ItemsCount);
+        if (display_start > already_submitted) //-V1051
+            ImGuiListClipper_SeekCursorForItem(clipper, display_start);
+        clipper->DisplayStart = display_start;
+        clipper->DisplayEnd = (heights && display_start < range_end) ? display_start + 1 : range_end;
+        if (clipper->DisplayEnd >= range_end)
+            data->StepNo++;
         if (clipper->DisplayStart == clipper->DisplayEnd && data->StepNo < data->Ranges.Size)
             continue;
+        if (heights && clipper->DisplayStart < clipper->DisplayEnd)
+        {
+            data->MeasureItem = clipper->DisplayStart;
+            data->MeasureStartPosY = window->DC.CursorPos.y;
+        }
         return true;
     }
 
@@ -3685,8 +3984,12 @@ void ImGui::Shutdown()
     g.TabBars.Clear();
     g.CurrentTabBarStack.clear();
     g.ShrinkWidthBuffer.clear();
+    g.TextSizeCache.SetCapacity(0);
+    g.TextBlockIndices.clear_delete();
+    g.TextBlockIndicesMap.Clear();
 
     g.ClipperTempData.clear_destruct();
+    g.ClipperHeights.clear_delete();
 
     g.Tables.Clear();
     g.TablesTempData.clear_destruct();
@@ -3696,6 +3999,8 @@ void ImGui::Shutdown()
     g.MenusIdSubmittedThisFrame.clear();
     g.InputTextState.ClearFreeMemory();
     g.InputTextDeactivatedState.ClearFreeMemory();
+    g.InputTextColorSpans.clear();
+    g.PlotColumns.clear();
 
     g.SettingsWindows.clear();
     g.SettingsHandlers.clear();
@@ -4538,7 +4843,7 @@ static void SetupDrawListSharedData()
     g.DrawListSharedData.InitialFlags = ImDrawListFlags_None;
     if (g.Style.AntiAliasedLines)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLines;
-    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & ImFontAtlasFlags_NoBakedLines))
+    if (g.Style.AntiAliasedLinesUseTex && !(g.IO.Fonts->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF)))
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesUseTex;
     if (g.Style.AntiAliasedFill)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
@@ -4570,8 +4875,16 @@ void ImGui::NewFrame()
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
+    g.WindowsOccludedCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
 
+    // Update text size cache
+    if (g.TextSizeCache.Capacity != ImMax(g.IO.ConfigTextSizeCacheSize, 0))
+        g.TextSizeCache.SetCapacity(g.IO.ConfigTextSizeCacheSize);
+    g.TextSizeCache.HitsCountLastFrame = g.TextSizeCache.HitsCount;
+    g.TextSizeCache.MissesCountLastFrame = g.TextSizeCache.MissesCount;
+    g.TextSizeCache.HitsCount = g.TextSizeCache.MissesCount = 0;
+
     // Calculate frame-rate for the user, as a purely luxurious feature
     g.FramerateSecPerFrameAccum += g.IO.DeltaTime - g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx];
     g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx] = g.IO.DeltaTime;
@@ -4586,6 +4899,10 @@ void ImGui::NewFrame()
     // Update viewports (after processing input queue, so io.MouseHoveredViewport is set)
     UpdateViewportsNewFrame();
 
+    // Rasterize glyphs requested during last frame (ImFontAtlasFlags_IncrementalGlyphs). Backend uploads modified regions during rendering.
+    if (g.IO.Fonts->IncrementalData != NULL && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates))
+        ImFontAtlasBuildUpdatePendingGlyphs(g.IO.Fonts);
+
     // Setup current font and draw list shared data
     g.IO.Fonts->Locked = true;
     SetupDrawListSharedData();
@@ -4760,6 +5077,33 @@ void ImGui::NewFrame()
     for (ImGuiTableTempData& table_temp_data : g.TablesTempData)
         if (table_temp_data.LastTimeActive >= 0.0f && table_temp_data.LastTimeActive < memory_compact_start_time)
             TableGcCompactTransientBuffers(&table_temp_data);
+
+    // Discard line indices of large text blocks which haven't been submitted during the previous frame
+    // (text blocks are identified by pointer: text rebuilt at a different address every frame would otherwise accumulate indices)
+    bool text_block_indices_removed = false;
+    for (int i = 0; i < g.TextBlockIndices.Size; i++)
+        if (g.TextBlockIndices[i]->LastFrameActive < g.FrameCount - 1)
+        {
+            IM_DELETE(g.TextBlockIndices[i]);
+            g.TextBlockIndices.erase(g.TextBlockIndices.Data + i);
+            text_block_indices_removed = true;
+            i--;
+        }
+    if (text_block_indices_removed)
+    {
+        g.TextBlockIndicesMap.Clear();
+        for (ImGuiTextBlockIndex* index : g.TextBlockIndices)
+            g.TextBlockIndicesMap.SetVoidPtr(ImHashData(&index->TextBegin, sizeof(index->TextBegin)), index);
+    }
+
+    // Garbage collect item heights of variable height clippers which haven't been used recently
+    for (int i = 0; i < g.ClipperHeights.Size; i++)
+        if (g.ClipperHeights[i]->LastTimeActive < memory_compact_start_time && (g.IO.ConfigMemoryCompactTimer >= 0.0f || g.GcCompactAll))
+        {
+            IM_DELETE(g.ClipperHeights[i]);
+            g.ClipperHeights.erase(g.ClipperHeights.Data + i);
+            i--;
+        }
     if (g.GcCompactAll)
         GcCompactTransientMiscBuffers();
     g.GcCompactAll = false;
@@ -5175,6 +5519,31 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
+
+    // Lookup cache (io.ConfigTextSizeCacheSize)
+    // (password font is excluded as its metrics are borrowed from the font it replaces)
+    ImGuiTextSizeCache* cache = &g.TextSizeCache;
+    ImU64 cache_key = 0;
+    const bool use_cache = (cache->Capacity > 0 && font->ContainerAtlas != NULL && font != &g.InputTextPasswordFont);
+    if (use_cache)
+    {
+        if (cache->FontAtlas != font->ContainerAtlas || cache->FontAtlasBuildCounter != font->ContainerAtlas->BuildCounter)
+        {
+            cache->Clear();
+            cache->FontAtlas = font->ContainerAtlas;
+            cache->FontAtlasBuildCounter = font->ContainerAtlas->BuildCounter;
+        }
+        const float key_params[2] = { font_size, wrap_width };
+        cache_key = ImHashData64(&font, sizeof(font), ImHashData64(key_params, sizeof(key_params)));
+        cache_key = ImHashData64(text, (size_t)(text_display_end - text), cache_key);
+        if (const ImVec2* cached_size = cache->Find(cache_key))
+        {
+            cache->HitsCount++;
+            return *cached_size;
+        }
+        cache->MissesCount++;
+    }
+
     ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
@@ -5184,6 +5553,8 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     // - https://embarkstudios.github.io/rust-gpu/api/src/libm/math/ceilf.rs.html
     text_size.x = IM_TRUNC(text_size.x + 0.99999f);
 
+    if (use_cache)
+        cache->Add(cache_key, text_size);
     return text_size;
 }
 
@@ -6140,10 +6511,12 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
         ImU32 title_bar_col = GetColorU32((title_bar_is_highlight && !g.NavDisableHighlight) ? ImGuiCol_TitleBgActive : ImGuiCol_TitleBgCollapsed);
         RenderFrame(title_bar_rect.Min, title_bar_rect.Max, title_bar_col, true, window_rounding);
         g.Style.FrameBorderSize = backup_border_size;
+        window->IsOpaque = (title_bar_col & IM_COL32_A_MASK) == IM_COL32_A_MASK;
     }
     else
     {
         // Window background
+        window->IsOpaque = false;
         if (!(flags & ImGuiWindowFlags_NoBackground))
         {
             ImU32 bg_col = GetColorU32(GetWindowBgColorIdx(window));
@@ -6157,6 +6530,7 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
             if (override_alpha)
                 bg_col = (bg_col & ~IM_COL32_A_MASK) | (IM_F32_TO_INT8_SAT(alpha) << IM_COL32_A_SHIFT);
             window->DrawList->AddRectFilled(window->Pos + ImVec2(0, window->TitleBarHeight()), window->Pos + window->Size, bg_col, window_rounding, (flags & ImGuiWindowFlags_NoTitleBar) ? 0 : ImDrawFlags_RoundCornersBottom);
+            window->IsOpaque = (bg_col & IM_COL32_A_MASK) == IM_COL32_A_MASK;
         }
 
         // Title bar
@@ -6164,6 +6538,8 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
         {
             ImU32 title_bar_col = GetColorU32(title_bar_is_highlight ? ImGuiCol_TitleBgActive : ImGuiCol_TitleBg);
             window->DrawList->AddRectFilled(title_bar_rect.Min, title_bar_rect.Max, title_bar_col, window_rounding, ImDrawFlags_RoundCornersTop);
+            if ((title_bar_col & IM_COL32_A_MASK) != IM_COL32_A_MASK)
+                window->IsOpaque = false;
         }
 
         // Menu bar
@@ -6347,6 +6723,40 @@ ImGuiWindow* ImGui::FindBlockingModal(ImGuiWindow* window)
     return NULL;
 }
 
+// Return true if 'window' is fully covered by an opaque root window in front of it (io.ConfigWindowsOcclusionCulling).
+// - Only windows already submitted this frame are used as occluders: their position, size and opacity (recorded by RenderWindowDecorations())
+//   are final. Windows not submitted yet may be closed, collapsed, faded or moved this frame, and using last frame data would show a blank window.
+// - We only test coverage by a single window, and ignore tooltips.
+// - We never cull a window holding interaction state (focus, active item, open popups), as skipping its items would lose that state.
+static bool IsWindowOccludedByOpaqueWindow(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip))
+        return false;
+    if (window->Appearing || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0 || window->HiddenFramesCannotSkipItems > 0 || g.LogEnabled)
+        return false;
+    if ((g.NavWindow && g.NavWindow->RootWindow == window) || (g.ActiveIdWindow && g.ActiveIdWindow->RootWindow == window) || g.NavWindowingTarget == window)
+        return false;
+    for (ImGuiPopupData& popup : g.OpenPopupStack)
+        if (popup.Window == NULL || (popup.Window->ParentWindow && popup.Window->ParentWindow->RootWindow == window) || (popup.RestoreNavWindow && popup.RestoreNavWindow->RootWindow == window))
+            return false;
+
+    const ImRect window_rect = window->Rect();
+    for (int i = g.Windows.Size - 1; i >= 0; i--)
+    {
+        ImGuiWindow* occluder = g.Windows[i];
+        if (occluder == window)
+            break; // Only windows in front of us
+        if (!occluder->Active || occluder->Hidden || !occluder->IsOpaque || (occluder->Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Tooltip)))
+            continue; // Not submitted yet this frame, or not opaque
+        ImRect occluder_rect = occluder->Rect();
+        occluder_rect.Expand(-occluder->WindowRounding);
+        if (occluder_rect.Contains(window_rect))
+            return true;
+    }
+    return false;
+}
+
 // Push a new Dear ImGui window to add widgets to.
 // - A default window called "Debug" is automatically stacked at the beginning of every frame so you can use widgets without explicitly calling a Begin/End pair.
 // - Begin/End can be called multiple times during the frame with the same window name to append content.
@@ -7042,6 +7452,13 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         if (style.Alpha <= 0.0f)
             window->HiddenFramesCanSkipItems = 1;
 
+        // Skip windows fully covered by an opaque window in front of them
+        if (g.IO.ConfigWindowsOcclusionCulling && window->HiddenFramesCanSkipItems == 0 && IsWindowOccludedByOpaqueWindow(window))
+        {
+            window->HiddenFramesCanSkipItems = 1;
+            g.WindowsOccludedCount++;
+        }
+
         // Update the Hidden flag
         bool hidden_regular = (window->HiddenFramesCanSkipItems > 0) || (window->HiddenFramesCannotSkipItems > 0);
         window->Hidden = hidden_regular || (window->HiddenFramesForRenderOnly > 0);
@@ -9634,6 +10051,7 @@ static void ImGui::ErrorCheckNewFrameSanityChecks()
     IM_ASSERT((g.FrameCount == 0 || g.FrameCountEnded == g.FrameCount)  && "Forgot to call Render() or EndFrame() at the end of the previous frame?");
     IM_ASSERT(g.IO.DisplaySize.x >= 0.0f && g.IO.DisplaySize.y >= 0.0f  && "Invalid DisplaySize value!");
     IM_ASSERT(g.IO.Fonts->IsBuilt()                                     && "Font Atlas not built! Make sure you called ImGui_ImplXXXX_NewFrame() function for renderer backend, which should call io.Fonts->GetTexDataAsRGBA32() / GetTexDataAsAlpha8()");
+    IM_ASSERT((!(g.IO.Fonts->Flags & ImFontAtlasFlags_SDF) || (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasSdfFonts)) && "ImFontAtlasFlags_SDF requires a renderer backend with a distance field shader (ImGuiBackendFlags_RendererHasSdfFonts)");
     IM_ASSERT(g.Style.CurveTessellationTol > 0.0f                       && "Invalid style setting!");
     IM_ASSERT(g.Style.CircleTessellationMaxError > 0.0f                 && "Invalid style setting!");
     IM_ASSERT(g.Style.Alpha >= 0.0f && g.Style.Alpha <= 1.0f            && "Invalid style setting!"); // Allows us to avoid a few clamps in color computations
@@ -14286,6 +14704,14 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
     Text("%d visible windows, %d current allocations", io.MetricsRenderWindows, g.DebugAllocInfo.TotalAllocCount - g.DebugAllocInfo.TotalFreeCount);
+    if (io.ConfigWindowsOcclusionCulling)
+        Text("%d windows skipped by occlusion culling", g.WindowsOccludedCount);
+    if (g.TextSizeCache.Capacity > 0)
+    {
+        const ImGuiTextSizeCache* cache = &g.TextSizeCache;
+        const int lookups_count = cache->HitsCountLastFrame + cache->MissesCountLastFrame;
+        Text("Text size cache: %d/%d entries, %d/%d hits last frame (%.1f%%)", cache->Entries.Size, cache->Capacity, cache->HitsCountLastFrame, lookups_count, lookups_count ? cache->HitsCountLastFrame * 100.0f / lookups_count : 0.0f);
+    }
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
     Separator();
@@ -45,7 +45,8 @@ Index of this file:
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, Math Operators, ImColor)
 // [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
-// [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
+// [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImTextureRect, ImFontAtlasFlags, ImFontAtlas, ImFont)
+// [SECTION] Image Atlas API (ImImageAtlasPage, ImImageAtlas)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
 // [SECTION] Platform Dependent Interfaces (ImGuiPlatformImeData)
 // [SECTION] Obsolete functions and types
@@ -155,6 +156,7 @@ struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_t
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
+struct ImImageAtlas;                // Helper to pack many small user images into shared texture pages, to merge draw calls
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
@@ -171,6 +173,7 @@ struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
+struct ImGuiTreeClipper;            // Helper to manually clip large trees, using a flattened list of visible rows
 struct ImGuiViewport;               // A Platform Window (always only one in 'master' branch), in the future may represent Platform Monitor
 
 // Enumerations
@@ -605,6 +608,7 @@ namespace ImGui
     // Widgets: Input with Keyboard
     // - If you want to use InputText() with std::string or any custom dynamic string type, see misc/cpp/imgui_stdlib.h and comments in imgui_demo.cpp.
     // - Most of the ImGuiInputTextFlags flags are only useful for InputText() and not for InputFloatX, InputIntX, InputDouble etc.
+    // - While the widget is active, it edits its own copy of the text: modifying 'buf' externally only takes effect when the widget is activated again, and is overwritten by the next edit.
     IMGUI_API bool          InputText(const char* label, char* buf, size_t buf_size, ImGuiInputTextFlags flags = 0, ImGuiInputTextCallback callback = NULL, void* user_data = NULL);
     IMGUI_API bool          InputTextMultiline(const char* label, char* buf, size_t buf_size, const ImVec2& size = ImVec2(0, 0), ImGuiInputTextFlags flags = 0, ImGuiInputTextCallback callback = NULL, void* user_data = NULL);
     IMGUI_API bool          InputTextWithHint(const char* label, const char* hint, char* buf, size_t buf_size, ImGuiInputTextFlags flags = 0, ImGuiInputTextCallback callback = NULL, void* user_data = NULL);
@@ -773,12 +777,16 @@ namespace ImGui
     //        - TableNextRow() -> TableNextColumn()      -> Text("Hello 0") -> TableNextColumn()      -> Text("Hello 1")  // OK
     //        -                   TableNextColumn()      -> Text("Hello 0") -> TableNextColumn()      -> Text("Hello 1")  // OK: TableNextColumn() automatically gets to next row!
     //        - TableNextRow()                           -> Text("Hello 0")                                               // Not OK! Missing TableSetColumnIndex() or TableNextColumn()! Text will not appear!
+    //    - With many columns and horizontal scrolling, use 'while (TableNextVisibleColumn())' after TableNextRow() to only visit
+    //      columns which are in view, and ImGuiListClipper to only submit rows which are in view. Use TableGetColumnIndex() to
+    //      know which column you are in. Cost of submitting a row then scales with the number of visible columns.
     // - 5. Call EndTable()
     IMGUI_API bool          BeginTable(const char* str_id, int column, ImGuiTableFlags flags = 0, const ImVec2& outer_size = ImVec2(0.0f, 0.0f), float inner_width = 0.0f);
     IMGUI_API void          EndTable();                                         // only call EndTable() if BeginTable() returns true!
     IMGUI_API void          TableNextRow(ImGuiTableRowFlags row_flags = 0, float min_row_height = 0.0f); // append into the first cell of a new row.
     IMGUI_API bool          TableNextColumn();                                  // append into the next column (or first column of next row if currently in last column). Return true when column is visible.
     IMGUI_API bool          TableSetColumnIndex(int column_n);                  // append into the specified column. Return true when column is visible.
+    IMGUI_API bool          TableNextVisibleColumn();                           // append into the next visible column of current row, skipping clipped columns. Return false when no visible column is left in the row.
 
     // Tables: Headers & Columns declaration
     // - Use TableSetupColumn() to specify label, resizing policy, default width/weight, id, various other flags etc.
@@ -1057,7 +1065,7 @@ enum ImGuiChildFlags_
 };
 
 // Flags for ImGui::InputText()
-// (Those are per-item flags. There are shared flags in ImGuiIO: io.ConfigInputTextCursorBlink and io.ConfigInputTextEnterKeepActive)
+// (Those are per-item flags. There are shared flags in ImGuiIO: io.ConfigInputTextCursorBlink, io.ConfigInputTextEnterKeepActive and io.ConfigInputTextUndoMemory)
 enum ImGuiInputTextFlags_
 {
     ImGuiInputTextFlags_None                = 0,
@@ -1082,6 +1090,7 @@ enum ImGuiInputTextFlags_
     ImGuiInputTextFlags_CallbackResize      = 1 << 18,  // Callback on buffer capacity changes request (beyond 'buf_size' parameter value), allowing the string to grow. Notify when the string wants to be resized (for string types which hold a cache of their Size). You will be provided a new BufSize in the callback and NEED to honor it. (see misc/cpp/imgui_stdlib.h for an example of using this)
     ImGuiInputTextFlags_CallbackEdit        = 1 << 19,  // Callback on any edit (note that InputText() already returns true on edit, the callback is useful mainly to manipulate the underlying buffer while focus is active)
     ImGuiInputTextFlags_EscapeClearsAll     = 1 << 20,  // Escape key clears content if not empty, and deactivate otherwise (contrast to default behavior of Escape to revert)
+    ImGuiInputTextFlags_CallbackColor       = 1 << 21,  // Callback on each visible line of InputTextMultiline() to color it (e.g. syntax highlighting). Call AddColorSpan() in the callback. While active, results are cached per line until the line is edited or data->ClearColorCache() is called from any callback.
 
     // Obsolete names
     //ImGuiInputTextFlags_AlwaysInsertMode  = ImGuiInputTextFlags_AlwaysOverwrite   // [renamed in 1.82] name was not matching behavior
@@ -1485,6 +1494,8 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasTexUpdates = 1 << 4,   // Backend Renderer supports ImFontAtlas::TexUpdates[] (partial uploads + texture resize). This enables ImFontAtlasFlags_IncrementalGlyphs.
+    ImGuiBackendFlags_RendererHasSdfFonts   = 1 << 5,   // Backend Renderer samples the font atlas texture through a distance field shader when ImFontAtlasFlags_SDF is set. This enables ImFontAtlasFlags_SDF.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -2091,9 +2102,12 @@ struct ImGuiIO
     bool        ConfigInputTrickleEventQueue;   // = true           // Enable input queue trickling: some types of events submitted during the same frame (e.g. button down + up) will be spread over multiple frames, improving interactions with low framerates.
     bool        ConfigInputTextCursorBlink;     // = true           // Enable blinking cursor (optional as some users consider it to be distracting).
     bool        ConfigInputTextEnterKeepActive; // = false          // [BETA] Pressing Enter will keep item active and select contents (single-line only).
+    int         ConfigInputTextUndoMemory;      // = 1 MB           // Maximum size of the undo/redo history of the active text field, in bytes. Allocated as needed and freed when another field is activated. Oldest steps are discarded past that. 0 to disable undo.
     bool        ConfigDragClickToInputText;     // = false          // [BETA] Enable turning DragXXX widgets into text input with a simple mouse click-release (without moving). Not desirable on devices without a keyboard.
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
+    bool        ConfigWindowsOcclusionCulling;  // = false          // [BETA] Skip items submission and rendering of windows fully covered by an opaque window in front of them and submitted before them during the frame. Begin() returns false for them, like for a collapsed window.
+    int         ConfigTextSizeCacheSize;        // = 0              // [BETA] Number of CalcTextSize() results kept in a LRU cache, to avoid measuring the same labels every frame (e.g. 4096). 0 to disable. Cache is cleared when fonts are rebuilt.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
 
     // Inputs Behaviors
@@ -2151,6 +2165,13 @@ struct ImGuiIO
     // (default to use native imm32 api on Windows)
     void        (*SetPlatformImeDataFn)(ImGuiViewport* viewport, ImGuiPlatformImeData* data);
 
+    // Optional: Run independent jobs on your own job system (used by ImDrawData helpers: ScaleClipRects(), ScaleVertexPositions(), DeIndexAllBuffers(), ForEachDrawList(), and by font atlas building)
+    // Must call 'job(job_data, n)' for every n in [0..count) and only return once all calls are completed. Calls for different 'n' may run concurrently.
+    // Jobs may allocate memory (e.g. glyph rasterization), so allocators passed to SetAllocatorFunctions() need to be thread-safe.
+    // (default to NULL: jobs are run serially on the calling thread)
+    void        (*ParallelForFn)(void* user_data, int count, void (*job)(void* job_data, int n), void* job_data);
+    void*       ParallelForUserData;
+
     // Optional: Platform locale
     ImWchar     PlatformLocaleDecimalPoint;     // '.'              // [Experimental] Configure decimal point e.g. '.' or ',' useful for some languages (e.g. German), generally pulled from *localeconv()->decimal_point
 
@@ -2281,21 +2302,26 @@ struct ImGuiInputTextCallbackData
     // - However, during Completion/History/Always callback, Buf always points to our own internal data (it is not the same as your buffer)! Changes to it will be reflected into your own buffer shortly after the callback.
     // - To modify the text buffer in a callback, prefer using the InsertChars() / DeleteChars() function. InsertChars() will take care of calling the resize callback if necessary.
     // - If you know your edits are not going to resize the underlying buffer allocation, you may modify the contents of 'Buf[]' directly. You need to update 'BufTextLen' accordingly (0 <= BufTextLen < BufSize) and set 'BufDirty'' to true so InputText can update its internal state.
+    // - During Color callback, Buf points to the line to color, which is NOT zero-terminated (use BufTextLen), and must not be modified.
     ImWchar             EventChar;      // Character input                      // Read-write   // [CharFilter] Replace character with another one, or set to zero to drop. return 1 is equivalent to setting EventChar=0;
     ImGuiKey            EventKey;       // Key pressed (Up/Down/TAB)            // Read-only    // [Completion,History]
-    char*               Buf;            // Text buffer                          // Read-write   // [Resize] Can replace pointer / [Completion,History,Always] Only write to pointed data, don't replace the actual pointer!
-    int                 BufTextLen;     // Text length (in bytes)               // Read-write   // [Resize,Completion,History,Always] Exclude zero-terminator storage. In C land: == strlen(some_text), in C++ land: string.length()
+    int                 EventLine;      // Line number (0-based)                // Read-only    // [Color]
+    char*               Buf;            // Text buffer                          // Read-write   // [Resize] Can replace pointer / [Completion,History,Always] Only write to pointed data, don't replace the actual pointer! / [Color] Read-only
+    int                 BufTextLen;     // Text length (in bytes)               // Read-write   // [Resize,Completion,History,Always] Exclude zero-terminator storage. In C land: == strlen(some_text), in C++ land: string.length() / [Color] Line length, excluding '\n'
     int                 BufSize;        // Buffer size (in bytes) = capacity+1  // Read-only    // [Resize,Completion,History,Always] Include zero-terminator storage. In C land == ARRAYSIZE(my_char_array), in C++ land: string.capacity()+1
     bool                BufDirty;       // Set if you modify Buf/BufTextLen!    // Write        // [Completion,History,Always]
     int                 CursorPos;      //                                      // Read-write   // [Completion,History,Always]
     int                 SelectionStart; //                                      // Read-write   // [Completion,History,Always] == to SelectionEnd when no selection)
     int                 SelectionEnd;   //                                      // Read-write   // [Completion,History,Always]
+    bool                ColorCacheDirty; // Set to recolor all lines!           // Write        // [Completion,History,Edit,Always,Color] Call ClearColorCache(). e.g. when your coloring rules changed while the widget is active.
 
     // Helper functions for text manipulation.
     // Use those function to benefit from the CallbackResize behaviors. Calling those function reset the selection.
     IMGUI_API ImGuiInputTextCallbackData();
     IMGUI_API void      DeleteChars(int pos, int bytes_count);
     IMGUI_API void      InsertChars(int pos, const char* text, const char* text_end = NULL);
+    IMGUI_API void      AddColorSpan(int pos, int bytes_count, ImU32 col);  // [Color] Color 'bytes_count' bytes of the line starting at 'pos'. Submit spans in order, uncolored text uses ImGuiCol_Text.
+    void                ClearColorCache()       { ColorCacheDirty = true; }                 // [Color] Request all lines to be colored again on next render, dropping spans cached by ImGuiInputTextFlags_CallbackColor.
     void                SelectAll()             { SelectionStart = 0; SelectionEnd = BufTextLen; }
     void                ClearSelection()        { SelectionStart = SelectionEnd = BufTextLen; }
     bool                HasSelection() const    { return SelectionStart != SelectionEnd; }
@@ -2471,6 +2497,13 @@ struct ImGuiStorage
 // - Clipper calculate the actual range of elements to display based on the current clipping rectangle, position the cursor before the first visible element.
 // - User code submit visible elements.
 // - The clipper also handles various subtleties related to keyboard/gamepad navigation, wrapping etc.
+// If your items have different heights (e.g. wrapped text, expandable rows), use BeginVariableHeight() instead of Begin():
+//   ImGuiListClipper clipper;
+//   clipper.BeginVariableHeight(ImGui::GetID("##items"), 1000);
+//   while (clipper.Step())
+//       for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//           ImGui::TextWrapped("%s", items[i]);
+// - Clipper gives you one item per step and measures it. Heights are kept across frames and items which haven't been displayed yet use an estimate.
 struct ImGuiListClipper
 {
     ImGuiContext*   Ctx;                // Parent UI context
@@ -2489,6 +2522,13 @@ struct ImGuiListClipper
     IMGUI_API void  End();             // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool  Step();            // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
 
+    // Variable height items: call BeginVariableHeight() instead of Begin().
+    // - id: identify storage for item heights, kept across frames (e.g. GetID("##items")). Seeking an item or a position is O(log items_count).
+    // - items_height_estimate: height assumed for items which haven't been displayed yet. Use -1.0f to use the height of the first item.
+    // Call SetItemHeight() to provide a known height, or with 0.0f to forget the height of an item after its contents changed.
+    IMGUI_API void  BeginVariableHeight(ImGuiID id, int items_count, float items_height_estimate = -1.0f);
+    IMGUI_API void  SetItemHeight(int item_index, float item_height);
+
     // Call IncludeItemByIndex() or IncludeItemsByIndex() *BEFORE* first call to Step() if you need a range of items to not be clipped, regardless of their visibility.
     // (Due to alignment / padding of certain items it is possible that an extra item may be included on either end of the display range).
     inline void     IncludeItemByIndex(int item_index)                  { IncludeItemsByIndex(item_index, item_index + 1); }
@@ -2501,6 +2541,41 @@ struct ImGuiListClipper
 #endif
 };
 
+// Helper: Manually clip large trees.
+// Submitting a tree with TreeNode()/TreePop() requires traversing every open node every frame. Instead, this helper keeps a
+// flattened list of visible rows (nodes whose ancestors are all open) and lets ImGuiListClipper submit only the rows in view.
+// - Your tree is described by two callbacks: get_children_count(user_data, node) and get_child(user_data, node, n), node==NULL being the root.
+//   Nodes are opaque pointers, which must stay valid and unique while the node is in the tree (they are used to identify nodes).
+// - Callbacks are only called when building rows: on first use, when a node gets opened, and after SetDirty().
+//   Children of closed nodes are never queried (other than their count), so you may lazily load them on opening.
+// - Open/close state is stored in the window storage like TreeNode(), under an ID computed from the node pointer.
+//   Rows toggled during a frame are updated when calling End(), their children are displayed on the next frame.
+//   If you change your tree or the open state of nodes which are not in view (e.g. with TreeNodeSetOpen()), call SetDirty().
+// - Keyboard/gamepad navigation works across clipped rows, including ImGuiTreeNodeFlags_NavLeftJumpsBackHere.
+// Usage:
+//   static ImGuiTreeClipper tree;         // Persistent: holds rows
+//   ImGuiListClipper clipper;
+//   tree.Begin(&clipper, GetChildrenCount, GetChild, &my_data);
+//   while (clipper.Step())
+//       for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd; row_n++)
+//           tree.TreeNode(row_n, "%s", ((MyNode*)tree.GetRowNode(row_n))->Name); // Don't call TreePop(), End() takes care of it.
+//   tree.End();
+struct ImGuiTreeClipper
+{
+    void*           TempData;           // [Internal] Internal data (flattened rows)
+
+    IMGUI_API ImGuiTreeClipper();
+    IMGUI_API ~ImGuiTreeClipper();
+    IMGUI_API void  Begin(ImGuiListClipper* clipper, int (*get_children_count)(void* user_data, void* node), void* (*get_child)(void* user_data, void* node, int child_n), void* user_data, ImGuiTreeNodeFlags flags = 0); // Calls clipper->Begin()
+    IMGUI_API void  End();              // Call after the clipper loop.
+    IMGUI_API bool  TreeNode(int row_n, const char* fmt, ...) IM_FMTARGS(3); // Submit tree node for a row, using 'flags' passed to Begin(). Return true when open.
+    IMGUI_API bool  TreeNodeV(int row_n, const char* fmt, va_list args) IM_FMTLIST(3);
+    IMGUI_API void  SetDirty();         // Rebuild rows on next Begin()
+    IMGUI_API void* GetRowNode(int row_n) const;
+    IMGUI_API int   GetRowDepth(int row_n) const;
+    IMGUI_API int   GetRowsCount() const;
+};
+
 // Helpers: ImVec2/ImVec4 operators
 // - It is important that we are keeping those disabled by default so they don't leak in user space.
 // - This is in order to allow user enabling implicit cast operators between ImVec2/ImVec4 and their own types (using IM_VEC2_CLASS_EXTRA in imconfig.h)
@@ -2869,6 +2944,8 @@ struct ImDrawData
     IMGUI_API void  AddDrawList(ImDrawList* draw_list);     // Helper to add an external draw list into an existing ImDrawData.
     IMGUI_API void  DeIndexAllBuffers();                    // Helper to convert all buffers from indexed to non-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
     IMGUI_API void  ScaleClipRects(const ImVec2& fb_scale); // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than Dear ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
+    IMGUI_API void  ScaleVertexPositions(const ImVec2& scale); // Helper to scale the pos field of each ImDrawVert. Use e.g. to apply a DPI scale to vertices instead of to the projection matrix (pair with ScaleClipRects()).
+    IMGUI_API void  ForEachDrawList(void (*func)(ImDrawList* draw_list, void* user_data), void* user_data); // Helper to run a custom pass (e.g. color-space conversion of ImDrawVert::col) over each ImDrawList. Runs concurrently through io.ParallelForFn if set: 'func' must only touch the draw list it is given.
 };
 
 //-----------------------------------------------------------------------------
@@ -2944,6 +3021,13 @@ struct ImFontAtlasCustomRect
     bool IsPacked() const           { return X != 0xFFFF; }
 };
 
+// A rectangular region of a texture, in pixels.
+struct ImTextureRect
+{
+    unsigned short  x, y;           // Upper-left coordinates
+    unsigned short  w, h;           // Size (w == 0 means empty)
+};
+
 // Flags for ImFontAtlas build
 enum ImFontAtlasFlags_
 {
@@ -2951,6 +3035,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_IncrementalGlyphs  = 1 << 3,   // [BETA] Only rasterize ASCII glyphs during Build(), other glyphs within GlyphRanges[] are rasterized on first use by NewFrame(). Requires stb_truetype builder + a backend setting ImGuiBackendFlags_RendererHasTexUpdates.
+    ImFontAtlasFlags_SDF                = 1 << 4,   // [BETA] Bake glyphs as signed distance fields, so a single font size renders crisply at any scale (e.g. io.FontGlobalScale, SetWindowFontScale()). Requires a backend setting ImGuiBackendFlags_RendererHasSdfFonts. Implies ImFontAtlasFlags_NoBakedLines. OversampleH/OversampleV/RasterizerMultiply are ignored. See SdfSpread.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2996,6 +3082,16 @@ struct ImFontAtlas
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't build texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Atlas cache: save/load the output of Build() (pixels, glyphs, lookup tables, custom rectangles positions) to skip rasterization on next startup.
+    // - Set 'CacheFilename' before calling Build() to use it automatically: Build() loads the file if it matches current inputs, otherwise builds and writes it.
+    // - Cache is keyed on a hash of all fonts data, ImFontConfig settings, glyph ranges and custom rectangles: any change to them invalidates it.
+    // - Load functions must be called after adding fonts and custom rectangles. Cache data is specific to a Dear ImGui version and build configuration.
+    // - Not used with ImFontAtlasFlags_IncrementalGlyphs.
+    IMGUI_API bool              LoadCacheFromFile(const char* filename);
+    IMGUI_API bool              LoadCacheFromMemory(const void* data, size_t data_size);
+    IMGUI_API bool              SaveCacheToFile(const char* filename);
+    IMGUI_API bool              SaveCacheToMemory(ImVector<unsigned char>* out_data);
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -3020,7 +3116,11 @@ struct ImFontAtlas
 
     // You can request arbitrary rectangles to be packed into the atlas, for your own purposes.
     // - After calling Build(), you can query the rectangle position and render your pixels.
-    // - If you render colored output, set 'atlas->TexPixelsUseColors = true' as this may help some backends decide of prefered texture format.
+    // - With ImFontAtlasFlags_IncrementalGlyphs, rectangles added after Build() are packed immediately into the existing texture and recorded in TexUpdates[]:
+    //   render your pixels before the next Render(), or call AddTexUpdate() if you modify them later. Same for fonts added with AddFont() after Build().
+    // - If you render colored output, set 'atlas->TexPixelsUseColors = true' before the backend creates the font texture: most bundled backends otherwise upload
+    //   a single channel texture (GetTexDataAsAlpha8()) sampled as white + alpha, which drops your colors.
+    // - With ImFontAtlasFlags_SDF, alpha of your rectangles goes through the same distance field shader as glyphs: alpha >= 0.5 is opaque, below is transparent.
     // - You can also request your rectangles to be mapped as font glyph (given a font + Unicode point),
     //   so you can render e.g. custom colorful icons and use them as regular glyphs.
     // - Read docs/FONTS.md for more details about using colorful icons.
@@ -3028,6 +3128,7 @@ struct ImFontAtlas
     IMGUI_API int               AddCustomRectRegular(int width, int height);
     IMGUI_API int               AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset = ImVec2(0, 0));
     ImFontAtlasCustomRect*      GetCustomRectByIndex(int index) { IM_ASSERT(index >= 0); return &CustomRects[index]; }
+    IMGUI_API void              AddTexUpdate(int x, int y, int w, int h);   // Record a modified region of TexPixels, to be uploaded by a backend supporting ImGuiBackendFlags_RendererHasTexUpdates.
 
     // [Internal]
     IMGUI_API void              CalcCustomRectUV(const ImFontAtlasCustomRect* rect, ImVec2* out_uv_min, ImVec2* out_uv_max) const;
@@ -3043,11 +3144,13 @@ struct ImFontAtlas
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    const char*                 CacheFilename;      // = NULL     // Path to atlas cache file used by Build() to skip rasterization when inputs didn't change. Set NULL to disable.
+    int                         SdfSpread;          // = 4        // With ImFontAtlasFlags_SDF: distance in texels covered by the distance field on each side of glyph outlines. Texel alpha = 0.5 on the outline, +/- 0.5 at SdfSpread texels inside/outside.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        TexReady;           // Set when texture was built matching current font input
-    bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
+    bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format. When false, bundled OpenGL3 (3.3+/ES 3.0+, not WebGL), OpenGL2 and Vulkan backends upload a single channel texture.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
     int                         TexWidth;           // Texture width calculated during Build().
@@ -3058,6 +3161,7 @@ struct ImFontAtlas
     ImVector<ImFontAtlasCustomRect> CustomRects;    // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Configuration data
     ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // UVs for baked anti-aliased lines
+    ImVector<ImTextureRect>     TexUpdates;         // Regions of TexPixels modified since the texture was last uploaded (ImFontAtlasFlags_IncrementalGlyphs: new glyphs, fonts and custom rectangles, see AddTexUpdate()). Backend uploads them then clears the list. If TexWidth/TexHeight changed, the texture needs to be recreated instead.
 
     // [Internal] Font builder
     const ImFontBuilderIO*      FontBuilderIO;      // Opaque interface to a font builder (default to stb_truetype, can be changed to use FreeType by defining IMGUI_ENABLE_FREETYPE).
@@ -3066,23 +3170,30 @@ struct ImFontAtlas
     // [Internal] Packing data
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
+    void*                       IncrementalData;    // Persistent packer state and pending glyph requests for ImFontAtlasFlags_IncrementalGlyphs
+    int                         BuildCounter;       // Incremented every time glyphs or lookup tables of any font change (Build, incremental glyphs, AddRemapChar). Used to invalidate cached text measurements.
 
     // [Obsolete]
     //typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
     //typedef ImFontGlyphRangesBuilder GlyphRangesBuilder; // OBSOLETED in 1.67+
 };
 
+// Font glyph index is paged: a top-level table of blocks of 256 code-points pointing to dense leaves.
+#define IM_FONT_INDEX_PAGE_SHIFT    8
+#define IM_FONT_INDEX_PAGE_SIZE     (1 << IM_FONT_INDEX_PAGE_SHIFT)
+
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
 {
-    // Members: Hot ~20/24 bytes (for CalcTextSize)
-    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Sparse. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this this info, and are often bottleneck in large UI).
+    // Members: Hot ~32/40 bytes (for CalcTextSize)
+    ImVector<ImU16>             IndexPages;         // 12-16 // out //            // Paged index, top level: leaf number for each block of 256 code-points (IndexPages[c >> 8]). Unused blocks all point to leaf 0, which is empty.
+    ImVector<float>             IndexAdvanceX;      // 12-16 // out //            // Paged index, leaves of 256 entries. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this this info, and are often bottleneck in large UI).
     float                       FallbackAdvanceX;   // 4     // out // = FallbackGlyph->AdvanceX
     float                       FontSize;           // 4     // in  //            // Height of characters/line, set during loading (don't change after loading)
 
     // Members: Hot ~28/40 bytes (for CalcTextSize + render loop)
-    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Sparse. Index glyphs by Unicode code-point.
+    ImVector<ImWchar>           IndexLookup;        // 12-16 // out //            // Paged index, leaves of 256 entries. Index glyphs by Unicode code-point.
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out //            // All glyphs.
     const ImFontGlyph*          FallbackGlyph;      // 4-8   // out // = FindGlyph(FontFallbackChar)
 
@@ -3106,7 +3217,8 @@ struct ImFont
     IMGUI_API ~ImFont();
     IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    float                       GetCharAdvance(ImWchar c) const     { const int idx = GetIndexOffset(c); return (idx >= 0) ? IndexAdvanceX.Data[idx] : FallbackAdvanceX; }
+    int                         GetIndexOffset(ImWchar c) const     { const unsigned int page_n = (unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT; return (page_n < (unsigned int)IndexPages.Size) ? (int)(((unsigned int)IndexPages.Data[page_n] << IM_FONT_INDEX_PAGE_SHIFT) | ((unsigned int)c & (IM_FONT_INDEX_PAGE_SIZE - 1))) : -1; } // Offset of 'c' in IndexLookup[]/IndexAdvanceX[], -1 if out of index.
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
@@ -3121,12 +3233,81 @@ struct ImFont
     IMGUI_API void              BuildLookupTable();
     IMGUI_API void              ClearOutputData();
     IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API int               AllocIndexEntry(ImWchar c);
     IMGUI_API void              AddGlyph(const ImFontConfig* src_cfg, ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API void              SetGlyphVisible(ImWchar c, bool visible);
     IMGUI_API bool              IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last);
 };
 
+//-----------------------------------------------------------------------------
+// [SECTION] Image Atlas API (ImImageAtlasPage, ImImageAtlas)
+//-----------------------------------------------------------------------------
+
+// A texture page of an ImImageAtlas. Pixels are always stored as RGBA32 (same layout as ImFontAtlas::GetTexDataAsRGBA32()).
+struct ImImageAtlasPage
+{
+    ImTextureID     TexID;          // User data to refer to the texture once it has been created by your UpdateTextureFn handler.
+    int             Width, Height;  // Page size in pixels (copied from ImImageAtlas::PageWidth/PageHeight when creating the page)
+    unsigned int*   Pixels;         // 4 component per pixel, each component is unsigned 8-bit. Total size = Width * Height * 4
+    ImTextureRect   DirtyRect;      // Region modified since last call to ImImageAtlas::UpdateTextures()
+    int             ImagesCount;    // Number of images currently living in this page
+    int             LastUsedFrame;  // Last frame an image of this page was requested by GetImage(). Used to decide which page to evict.
+    void*           PackContext;    // [Internal] Rectangle packer state
+
+    ImImageAtlasPage()              { memset(this, 0, sizeof(*this)); LastUsedFrame = -1; }
+};
+
+// A packed image within an ImImageAtlas
+struct ImImageAtlasEntry
+{
+    ImGuiID         Key;            // User identifier passed to AddImage()
+    int             PageIndex;      // Index in ImImageAtlas::Pages[]
+    unsigned short  X, Y;           // Position within page
+    unsigned short  Width, Height;  // Size
+};
+
+// [BETA] Pack many small user images (icons, thumbnails) into a few shared texture pages.
+// Every distinct ImTextureID breaks the current ImDrawCmd, so e.g. a toolbar of 50 icons each using their own texture
+// is 50 draw calls. Images sharing a page are batched into the same ImDrawCmd.
+// Usage:
+//  - Once: set PageWidth/PageHeight/PagesMax and UpdateTextureFn.
+//  - Each frame: if (!atlas.GetImage(key, &tex_id, &uv0, &uv1)) atlas.AddImage(key, w, h, pixels) then GetImage() again.
+//    Use the output with ImGui::Image(tex_id, size, uv0, uv1) or ImDrawList::AddImage().
+//  - Before rendering: call UpdateTextures() to let your UpdateTextureFn upload modified regions of pages.
+// Eviction:
+//  - Space is never reclaimed per image. When no page has room and PagesMax is reached, the least recently used page
+//    is entirely evicted. Evicted images are reported as missing by GetImage() so you can add them again.
+//  - A page used during the current frame is never evicted, so that already submitted vertices keep valid UVs.
+//    In this case AddImage() fails and you should render your image with its own texture.
+// Textures:
+//  - Pages and their TexID are never destroyed before Clear() or destruction of the atlas: release your textures before.
+struct ImImageAtlas
+{
+    // Configuration
+    int                         PageWidth;          // = 1024   // Width of new pages
+    int                         PageHeight;         // = 1024   // Height of new pages
+    int                         PagesMax;           // = 4      // Maximum number of pages. When reached, pages get evicted to make room.
+    int                         Padding;            // = 1      // Padding between images in pixels, to avoid bleeding with bilinear filtering.
+    void                        (*UpdateTextureFn)(ImImageAtlas* atlas, ImImageAtlasPage* page, const ImTextureRect& rect); // Called by AddImage() when creating a page (page->TexID == 0: create texture and set page->TexID), then by UpdateTextures() for modified regions. Upload 'rect' from page->Pixels (pitch = page->Width * 4). If NULL, poll page->DirtyRect yourself.
+    void*                       UserData;           // Store your own data (e.g. to be used by UpdateTextureFn)
+
+    // Functions
+    IMGUI_API ImImageAtlas();
+    IMGUI_API ~ImImageAtlas();
+    IMGUI_API void              Clear();                                                                // Destroy all pages and images. Release page->TexID yourself before calling this.
+    IMGUI_API bool              AddImage(ImGuiID key, int width, int height, const unsigned char* rgba_pixels, int pitch = 0); // Copy image into a page. Returns false if it doesn't fit (e.g. too large, or all pages are used this frame). 'pitch' defaults to width * 4.
+    IMGUI_API bool              GetImage(ImGuiID key, ImTextureID* out_tex_id, ImVec2* out_uv0, ImVec2* out_uv1); // Return false if the image is not (or not anymore) in the atlas. Mark its page as used this frame.
+    IMGUI_API void              RemoveImage(ImGuiID key);                                               // Forget about an image. Its space is only reclaimed when its page gets evicted.
+    IMGUI_API void              UpdateTextures();                                                       // Call UpdateTextureFn for each modified page. Call once a frame before rendering.
+
+    // [Internal]
+    ImVector<ImImageAtlasPage>  Pages;
+    ImVector<ImImageAtlasEntry> Entries;
+    ImGuiStorage                EntriesMap;         // Key -> Index+1 in Entries[]
+    IMGUI_API void              EvictPage(int page_index);
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Viewports
 //-----------------------------------------------------------------------------
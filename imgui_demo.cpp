@@ -477,11 +477,19 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::SameLine(); HelpMarker("Enable blinking cursor (optional as some users consider it to be distracting).");
             ImGui::Checkbox("io.ConfigInputTextEnterKeepActive", &io.ConfigInputTextEnterKeepActive);
             ImGui::SameLine(); HelpMarker("Pressing Enter will keep item active and select contents (single-line only).");
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+            ImGui::DragInt("io.ConfigInputTextUndoMemory", &io.ConfigInputTextUndoMemory, 1024.0f, 0, 64 * 1024 * 1024, "%d bytes");
+            ImGui::SameLine(); HelpMarker("Maximum size of the undo/redo history of the active text field. Allocated as needed and freed when another field is activated.\nOldest steps are discarded past that. 0 to disable undo.");
             ImGui::Checkbox("io.ConfigDragClickToInputText", &io.ConfigDragClickToInputText);
             ImGui::SameLine(); HelpMarker("Enable turning DragXXX widgets into text input with a simple mouse click-release (without moving).");
             ImGui::Checkbox("io.ConfigWindowsResizeFromEdges", &io.ConfigWindowsResizeFromEdges);
             ImGui::SameLine(); HelpMarker("Enable resizing of windows from their edges and from the lower-left corner.\nThis requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback.");
             ImGui::Checkbox("io.ConfigWindowsMoveFromTitleBarOnly", &io.ConfigWindowsMoveFromTitleBarOnly);
+            ImGui::Checkbox("io.ConfigWindowsOcclusionCulling", &io.ConfigWindowsOcclusionCulling);
+            ImGui::SameLine(); HelpMarker("Skip items submission and rendering of windows fully covered by an opaque window submitted before them.\nNote that the default style uses a translucent WindowBg color, so set its alpha to 1.0 to make use of this.");
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+            ImGui::DragInt("io.ConfigTextSizeCacheSize", &io.ConfigTextSizeCacheSize, 16.0f, 0, 65536);
+            ImGui::SameLine(); HelpMarker("Number of CalcTextSize() results kept in a LRU cache. 0 to disable.\nSee hit rate in Metrics/Debugger window.");
             ImGui::Checkbox("io.ConfigMacOSXBehaviors", &io.ConfigMacOSXBehaviors);
             ImGui::Text("Also see Style->Rendering for rendering options.");
 
@@ -516,6 +524,8 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::CheckboxFlags("io.BackendFlags: HasMouseCursors",      &io.BackendFlags, ImGuiBackendFlags_HasMouseCursors);
             ImGui::CheckboxFlags("io.BackendFlags: HasSetMousePos",       &io.BackendFlags, ImGuiBackendFlags_HasSetMousePos);
             ImGui::CheckboxFlags("io.BackendFlags: RendererHasVtxOffset", &io.BackendFlags, ImGuiBackendFlags_RendererHasVtxOffset);
+            ImGui::CheckboxFlags("io.BackendFlags: RendererHasTexUpdates", &io.BackendFlags, ImGuiBackendFlags_RendererHasTexUpdates);
+            ImGui::CheckboxFlags("io.BackendFlags: RendererHasSdfFonts",  &io.BackendFlags, ImGuiBackendFlags_RendererHasSdfFonts);
             ImGui::EndDisabled();
             ImGui::TreePop();
             ImGui::Spacing();
@@ -994,6 +1004,39 @@ static void ShowDemoWindowWidgets()
                 ImGui::Indent(ImGui::GetTreeNodeToLabelSpacing());
             ImGui::TreePop();
         }
+
+        IMGUI_DEMO_MARKER("Widgets/Tree Nodes/Clipped tree");
+        if (ImGui::TreeNode("Clipped tree (1,010,100 nodes)"))
+        {
+            // ImGuiTreeClipper flattens the open parts of a tree into rows, which are then clipped by a ImGuiListClipper:
+            // only visible nodes are submitted, whatever the size of the tree and the number of open nodes.
+            // Nodes are opaque pointers retrieved with callbacks. They must stay valid while the tree is displayed,
+            // and their pointer value is used to identify them (call SetDirty() if your tree changes).
+            // Here we use an implicit tree with 100 roots, 100 children per root and 100 leaves per child:
+            // node 'n' is stored as (void*)(n + 1) and the children of node 'n' are (n + 1) * 100 + [0..99].
+            HelpMarker("Only visible rows are submitted. Try opening many nodes, then use arrow keys to navigate (Left jumps back to parent).");
+            struct Funcs
+            {
+                static int   GetChildrenCount(void*, void* node) { intptr_t n = (intptr_t)node - 1; return (n < 100 + 100 * 100) ? 100 : 0; } // NULL node is the root: n = -1
+                static void* GetChild(void*, void* node, int child_n) { intptr_t n = (intptr_t)node - 1; return (void*)(intptr_t)((n + 1) * 100 + child_n + 1); }
+            };
+            static ImGuiTreeClipper tree_clipper;
+            ImGui::Text("Rows: %d", tree_clipper.GetRowsCount());
+            if (ImGui::BeginChild("##tree", ImVec2(0.0f, ImGui::GetFontSize() * 20), ImGuiChildFlags_Border))
+            {
+                ImGuiListClipper clipper;
+                tree_clipper.Begin(&clipper, Funcs::GetChildrenCount, Funcs::GetChild, NULL, ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_NavLeftJumpsBackHere | ImGuiTreeNodeFlags_SpanAvailWidth);
+                while (clipper.Step())
+                    for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd; row_n++)
+                    {
+                        intptr_t n = (intptr_t)tree_clipper.GetRowNode(row_n) - 1;
+                        tree_clipper.TreeNode(row_n, "Node %d (depth %d)", (int)n, tree_clipper.GetRowDepth(row_n));
+                    }
+                tree_clipper.End();
+            }
+            ImGui::EndChild();
+            ImGui::TreePop();
+        }
         ImGui::TreePop();
     }
 
@@ -1652,6 +1695,74 @@ static void ShowDemoWindowWidgets()
             ImGui::TreePop();
         }
 
+        IMGUI_DEMO_MARKER("Widgets/Text Input/Syntax Coloring Callback");
+        if (ImGui::TreeNode("Syntax Coloring Callback"))
+        {
+            HelpMarker(
+                "Using ImGuiInputTextFlags_CallbackColor to color text.\n\n"
+                "The callback is called for visible lines only, and while editing, colors are cached until a line is modified "
+                "(call data->ClearColorCache() from any callback to color all lines again).");
+            struct Funcs
+            {
+                static bool IsIdentifierChar(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; }
+
+                // A very simple C-like tokenizer. Each line is colored independently.
+                static int MyColorCallback(ImGuiInputTextCallbackData* data)
+                {
+                    if (data->EventFlag != ImGuiInputTextFlags_CallbackColor)
+                        return 0;
+                    static const char* keywords[] = { "if", "else", "for", "while", "return", "int", "float", "void", "const", "struct" };
+                    const char* line = data->Buf;
+                    const int len = data->BufTextLen;
+                    for (int i = 0; i < len; )
+                    {
+                        const int start = i;
+                        if (line[i] == '/' && i + 1 < len && line[i + 1] == '/')
+                        {
+                            data->AddColorSpan(i, len - i, IM_COL32(106, 153, 85, 255)); // Comment until end of line
+                            break;
+                        }
+                        if (line[i] == '"')
+                        {
+                            for (i++; i < len && line[i] != '"'; i++) {}
+                            i = (i < len) ? i + 1 : len;
+                            data->AddColorSpan(start, i - start, IM_COL32(206, 145, 120, 255));
+                        }
+                        else if (line[i] >= '0' && line[i] <= '9')
+                        {
+                            while (i < len && (IsIdentifierChar(line[i]) || line[i] == '.'))
+                                i++;
+                            data->AddColorSpan(start, i - start, IM_COL32(181, 206, 168, 255));
+                        }
+                        else if (IsIdentifierChar(line[i]))
+                        {
+                            while (i < len && IsIdentifierChar(line[i]))
+                                i++;
+                            for (int n = 0; n < IM_ARRAYSIZE(keywords); n++)
+                                if ((int)strlen(keywords[n]) == i - start && strncmp(keywords[n], line + start, i - start) == 0)
+                                    data->AddColorSpan(start, i - start, IM_COL32(86, 156, 214, 255));
+                        }
+                        else
+                        {
+                            i++;
+                        }
+                    }
+                    return 0;
+                }
+            };
+            static char text[1024 * 4] =
+                "// Syntax coloring demo\n"
+                "int main(int argc, char** argv)\n"
+                "{\n"
+                "    const float value = 1.5f;\n"
+                "    for (int n = 0; n < 10; n++)\n"
+                "        printf(\"Hello %d\\n\", n); // Greetings\n"
+                "    return 0;\n"
+                "}\n";
+            ImGui::InputTextMultiline("##source", text, IM_ARRAYSIZE(text), ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 12), ImGuiInputTextFlags_AllowTabInput | ImGuiInputTextFlags_CallbackColor, Funcs::MyColorCallback);
+            ImGui::TreePop();
+        }
+
         IMGUI_DEMO_MARKER("Widgets/Text Input/Miscellaneous");
         if (ImGui::TreeNode("Miscellaneous"))
         {
@@ -1873,6 +1984,36 @@ static void ShowDemoWindowWidgets()
         float (*func)(void*, int) = (func_type == 0) ? Funcs::Sin : Funcs::Saw;
         ImGui::PlotLines("Lines", func, NULL, display_count, 0, NULL, -1.0f, 1.0f, ImVec2(0, 80));
         ImGui::PlotHistogram("Histogram", func, NULL, display_count, 0, NULL, -1.0f, 1.0f, ImVec2(0, 80));
+
+        // When there are more values than pixels, each pixel column displays the min/max of the values it covers,
+        // so isolated peaks stay visible. Contiguous float arrays are scanned faster than values provided by a function.
+        IMGUI_DEMO_MARKER("Widgets/Plotting/Large data");
+        ImGui::SeparatorText("Large data");
+        static bool large_enabled = false;
+        static ImVector<float> large_values;
+        ImGui::Checkbox("Plot 5,000,000 values", &large_enabled);
+        ImGui::SameLine(); HelpMarker("Uses 20 MB of memory. Values are noise with a few isolated spikes.");
+        if (large_enabled)
+        {
+            if (large_values.empty())
+            {
+                large_values.resize(5000000);
+                unsigned int seed = 1;
+                for (int n = 0; n < large_values.Size; n++)
+                {
+                    seed = seed * 1664525u + 1013904223u;
+                    large_values[n] = sinf(n * 0.00001f) * 0.5f + (float)(seed >> 8) / (float)(1 << 24) * 0.2f;
+                }
+                for (int n = 1; n < 8; n++)
+                    large_values[n * 612345] = (n & 1) ? 2.0f : -2.0f;
+            }
+            ImGui::PlotLines("Lines##large", large_values.Data, large_values.Size, 0, NULL, FLT_MAX, FLT_MAX, ImVec2(0, 80));
+            ImGui::PlotHistogram("Histogram##large", large_values.Data, large_values.Size, 0, NULL, FLT_MAX, FLT_MAX, ImVec2(0, 80));
+        }
+        else if (!large_values.empty())
+        {
+            large_values.clear();
+        }
         ImGui::Separator();
 
         // Animate a simple progress bar
@@ -4751,6 +4892,40 @@ static void ShowDemoWindowTables()
             }
             ImGui::EndTable();
         }
+
+        ImGui::Spacing();
+        ImGui::TextUnformatted("Many columns + clipping");
+        ImGui::SameLine();
+        HelpMarker(
+            "Showcase using ImGuiListClipper to only submit visible rows, and TableNextVisibleColumn() to only submit visible columns: "
+            "the cost of submitting contents scales with the number of cells in sight rather than with the size of the table.\n"
+            "Note that as with skipping columns when TableNextColumn() returns false, this requires all columns to have the same height.");
+        static ImGuiTableFlags flags3 = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable | ImGuiTableFlags_NoSavedSettings;
+        if (ImGui::BeginTable("table3", 2000, flags3, outer_size))
+        {
+            ImGui::TableSetupScrollFreeze(1, 1);
+            ImGui::TableSetupColumn("Line #", ImGuiTableColumnFlags_NoHide); // Other columns are left undeclared (no name)
+            ImGui::TableHeadersRow();
+            int cells_count = 0;
+            ImGuiListClipper clipper;
+            clipper.Begin(10000);
+            while (clipper.Step())
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    ImGui::TableNextRow();
+                    while (ImGui::TableNextVisibleColumn())
+                    {
+                        const int column = ImGui::TableGetColumnIndex();
+                        if (column == 0)
+                            ImGui::Text("Line %d", row);
+                        else
+                            ImGui::Text("Hello %d,%d", column, row);
+                        cells_count++;
+                    }
+                }
+            ImGui::EndTable();
+            ImGui::Text("Submitted %d cells out of %d.", cells_count, 10000 * 2000);
+        }
         ImGui::TreePop();
     }
 
@@ -6455,14 +6630,19 @@ void ImGui::ShowAboutWindow(bool* p_open)
         if (io.MouseDrawCursor)                                         ImGui::Text("io.MouseDrawCursor");
         if (io.ConfigMacOSXBehaviors)                                   ImGui::Text("io.ConfigMacOSXBehaviors");
         if (io.ConfigInputTextCursorBlink)                              ImGui::Text("io.ConfigInputTextCursorBlink");
+        ImGui::Text("io.ConfigInputTextUndoMemory = %d", io.ConfigInputTextUndoMemory);
         if (io.ConfigWindowsResizeFromEdges)                            ImGui::Text("io.ConfigWindowsResizeFromEdges");
         if (io.ConfigWindowsMoveFromTitleBarOnly)                       ImGui::Text("io.ConfigWindowsMoveFromTitleBarOnly");
+        if (io.ConfigWindowsOcclusionCulling)                           ImGui::Text("io.ConfigWindowsOcclusionCulling");
+        if (io.ConfigTextSizeCacheSize > 0)                             ImGui::Text("io.ConfigTextSizeCacheSize = %d", io.ConfigTextSizeCacheSize);
         if (io.ConfigMemoryCompactTimer >= 0.0f)                        ImGui::Text("io.ConfigMemoryCompactTimer = %.1f", io.ConfigMemoryCompactTimer);
         ImGui::Text("io.BackendFlags: 0x%08X", io.BackendFlags);
         if (io.BackendFlags & ImGuiBackendFlags_HasGamepad)             ImGui::Text(" HasGamepad");
         if (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors)        ImGui::Text(" HasMouseCursors");
         if (io.BackendFlags & ImGuiBackendFlags_HasSetMousePos)         ImGui::Text(" HasSetMousePos");
         if (io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)   ImGui::Text(" RendererHasVtxOffset");
+        if (io.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates)  ImGui::Text(" RendererHasTexUpdates");
+        if (io.BackendFlags & ImGuiBackendFlags_RendererHasSdfFonts)    ImGui::Text(" RendererHasSdfFonts");
         ImGui::Separator();
         ImGui::Text("io.Fonts: %d fonts, Flags: 0x%08X, TexSize: %d,%d", io.Fonts->Fonts.Size, io.Fonts->Flags, io.Fonts->TexWidth, io.Fonts->TexHeight);
         ImGui::Text("io.DisplaySize: %.2f,%.2f", io.DisplaySize.x, io.DisplaySize.y);
@@ -7670,7 +7850,9 @@ static void ShowExampleAppLongText(bool* p_open)
     ImGui::Combo("Test type", &test_type,
         "Single call to TextUnformatted()\0"
         "Multiple calls to Text(), clipped\0"
-        "Multiple calls to Text(), not clipped (slow)\0");
+        "Multiple calls to Text(), not clipped (slow)\0"
+        "Single call to InputTextMultiline(), editable\0"
+        "Multiple calls to TextWrapped(), variable height, clipped\0");
     ImGui::Text("Buffer contents: %d lines, %d bytes", lines, log.size());
     if (ImGui::Button("Clear")) { log.clear(); lines = 0; }
     ImGui::SameLine();
@@ -7680,6 +7862,23 @@ static void ShowExampleAppLongText(bool* p_open)
             log.appendf("%i The quick brown fox jumps over the lazy dog\n", lines + i);
         lines += 1000;
     }
+    if (test_type == 3)
+    {
+        // Fill with a given amount of text, to measure the cost of editing large buffers
+        const char* fill_names[] = { "Fill 1 KB", "Fill 100 KB", "Fill 10 MB" };
+        const int fill_sizes[] = { 1 << 10, 100 << 10, 10 << 20 };
+        for (int n = 0; n < IM_ARRAYSIZE(fill_sizes); n++)
+        {
+            ImGui::SameLine();
+            if (ImGui::Button(fill_names[n]))
+            {
+                log.clear();
+                lines = 0;
+                while (log.size() < fill_sizes[n])
+                    log.appendf("%i The quick brown fox jumps over the lazy dog\n", lines++);
+            }
+        }
+    }
     ImGui::BeginChild("Log");
     switch (test_type)
     {
@@ -7706,6 +7905,45 @@ static void ShowExampleAppLongText(bool* p_open)
             ImGui::Text("%i The quick brown fox jumps over the lazy dog", i);
         ImGui::PopStyleVar();
         break;
+    case 3:
+        {
+            // Edit the buffer in place, using ImGuiInputTextFlags_CallbackResize to let it grow (see "Resize Callback" demo).
+            // Line count is not updated while editing.
+            struct Funcs
+            {
+                static int ResizeCallback(ImGuiInputTextCallbackData* data)
+                {
+                    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
+                    {
+                        ImVector<char>* buf = (ImVector<char>*)data->UserData;
+                        buf->resize(data->BufSize);
+                        data->Buf = buf->Data;
+                    }
+                    return 0;
+                }
+            };
+            if (log.Buf.empty())
+                log.Buf.push_back(0);
+            if (ImGui::InputTextMultiline("##Edit", log.Buf.Data, (size_t)log.Buf.Size, ImVec2(-FLT_MIN, -FLT_MIN), ImGuiInputTextFlags_CallbackResize, Funcs::ResizeCallback, (void*)&log.Buf))
+                log.Buf.resize((int)strlen(log.Buf.Data) + 1); // Keep log.size() and appendf() correct after deleting text
+            break;
+        }
+    case 4:
+        {
+            // Multiple calls to TextWrapped(), with items of different heights.
+            // ImGuiListClipper::BeginVariableHeight() measures each item as it is displayed and stores heights under the given ID,
+            // items which haven't been displayed yet are assumed to be of the estimated height. Here we estimate a single line.
+            const char* sentence = "The quick brown fox jumps over the lazy dog. "; // 45 characters
+            char paragraph[45 * 5 + 1] = "";
+            for (int n = 0; n < 5; n++)
+                strcat(paragraph, sentence);
+            ImGuiListClipper clipper;
+            clipper.BeginVariableHeight(ImGui::GetID("##Wrapped"), lines, ImGui::GetTextLineHeightWithSpacing());
+            while (clipper.Step())
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                    ImGui::TextWrapped("%i %.*s", i, 45 * (1 + (i * 7) % 5), paragraph);
+            break;
+        }
     }
     ImGui::EndChild();
     ImGui::End();
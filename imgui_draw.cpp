@@ -14,9 +14,11 @@ Index of this file:
 // [SECTION] Helpers ShadeVertsXXX functions
 // [SECTION] ImFontConfig
 // [SECTION] ImFontAtlas
+// [SECTION] ImFontAtlas cache
 // [SECTION] ImFontAtlas glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFont
+// [SECTION] ImImageAtlas
 // [SECTION] ImGui Internal Render Helpers
 // [SECTION] Decompression code
 // [SECTION] Default font data (ProggyClean.ttf)
@@ -130,8 +132,22 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Glyphs may be rasterized from concurrent jobs (see ImGui::ParallelFor()): we call allocator functions directly,
+// as the debug allocation tracking done by ImGui::MemAlloc()/MemFree() is not thread-safe.
+static void* ImStbTrueTypeMemAlloc(size_t size)
+{
+    ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+    return alloc_func(size, user_data);
+}
+static void ImStbTrueTypeMemFree(void* ptr)
+{
+    ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+    free_func(ptr, user_data);
+}
+#define STBTT_malloc(x,u)   ((void)(u), ImStbTrueTypeMemAlloc(x))
+#define STBTT_free(x,u)     ((void)(u), ImStbTrueTypeMemFree(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -735,7 +751,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         const bool use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
 
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
-        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF)));
 
         const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
@@ -2219,23 +2235,78 @@ void ImDrawData::AddDrawList(ImDrawList* draw_list)
     ImGui::AddDrawListToDrawDataEx(this, &CmdLists, draw_list);
 }
 
+// Run 'job' for each n in [0..count), dispatched through io.ParallelForFn when the application provides one.
+// Also used by the font atlas builder, which may run without a current context: we then run serially.
+// Every ImDrawList is independent from others, so all ImDrawData helpers below are distributing one job per draw list.
+void ImGui::ParallelFor(int count, void (*job)(void* job_data, int n), void* job_data)
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx != NULL && ctx->IO.ParallelForFn != NULL && count > 1)
+    {
+        ctx->IO.ParallelForFn(ctx->IO.ParallelForUserData, count, job, job_data);
+        return;
+    }
+    for (int n = 0; n < count; n++)
+        job(job_data, n);
+}
+
+struct ImDrawDataDeIndexJob
+{
+    ImDrawData*             DrawData;
+    ImVector<ImDrawVert>*   NewVtxBuffers;  // One per draw list, already allocated
+};
+
+static void ImDrawData_DeIndexJob(void* job_data, int n)
+{
+    ImDrawDataDeIndexJob* data = (ImDrawDataDeIndexJob*)job_data;
+    ImDrawList* draw_list = data->DrawData->CmdLists[n];
+    if (draw_list->IdxBuffer.empty())
+        return;
+    ImVector<ImDrawVert>& new_vtx_buffer = data->NewVtxBuffers[n];
+    IM_ASSERT(new_vtx_buffer.Size == draw_list->IdxBuffer.Size);
+    const ImDrawVert* src_vtx = draw_list->VtxBuffer.Data;
+    const ImDrawIdx* src_idx = draw_list->IdxBuffer.Data;
+    for (int j = 0; j < draw_list->IdxBuffer.Size; j++)
+        new_vtx_buffer.Data[j] = src_vtx[src_idx[j]];
+    draw_list->VtxBuffer.swap(new_vtx_buffer);
+    draw_list->IdxBuffer.resize(0);
+}
+
 // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
+// Jobs don't allocate: ImGui::MemAlloc()/MemFree() are not thread-safe, so output buffers are allocated before and old buffers freed after.
 void ImDrawData::DeIndexAllBuffers()
 {
-    ImVector<ImDrawVert> new_vtx_buffer;
+    ImVector<ImVector<ImDrawVert> > new_vtx_buffers;
+    new_vtx_buffers.resize(CmdListsCount, ImVector<ImDrawVert>());
+    for (int i = 0; i < CmdListsCount; i++)
+        new_vtx_buffers[i].resize(CmdLists[i]->IdxBuffer.Size);
+    ImDrawDataDeIndexJob data = { this, new_vtx_buffers.Data };
+    ImGui::ParallelFor(CmdListsCount, ImDrawData_DeIndexJob, &data);
+    new_vtx_buffers.clear_destruct();
     TotalVtxCount = TotalIdxCount = 0;
     for (int i = 0; i < CmdListsCount; i++)
-    {
-        ImDrawList* cmd_list = CmdLists[i];
-        if (cmd_list->IdxBuffer.empty())
-            continue;
-        new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
-        for (int j = 0; j < cmd_list->IdxBuffer.Size; j++)
-            new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
-        cmd_list->VtxBuffer.swap(new_vtx_buffer);
-        cmd_list->IdxBuffer.resize(0);
-        TotalVtxCount += cmd_list->VtxBuffer.Size;
-    }
+        TotalVtxCount += CmdLists[i]->VtxBuffer.Size;
+}
+
+struct ImDrawDataScaleJob
+{
+    ImDrawData* DrawData;
+    ImVec2      Scale;
+};
+
+static void ImDrawData_ScaleClipRectsJob(void* job_data, int n)
+{
+    ImDrawDataScaleJob* data = (ImDrawDataScaleJob*)job_data;
+    ImDrawList* draw_list = data->DrawData->CmdLists[n];
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 scale = _mm_setr_ps(data->Scale.x, data->Scale.y, data->Scale.x, data->Scale.y);
+    for (ImDrawCmd& cmd : draw_list->CmdBuffer)
+        _mm_storeu_ps(&cmd.ClipRect.x, _mm_mul_ps(_mm_loadu_ps(&cmd.ClipRect.x), scale));
+#else
+    const ImVec2 scale = data->Scale;
+    for (ImDrawCmd& cmd : draw_list->CmdBuffer)
+        cmd.ClipRect = ImVec4(cmd.ClipRect.x * scale.x, cmd.ClipRect.y * scale.y, cmd.ClipRect.z * scale.x, cmd.ClipRect.w * scale.y);
+#endif
 }
 
 // Helper to scale the ClipRect field of each ImDrawCmd.
@@ -2243,9 +2314,61 @@ void ImDrawData::DeIndexAllBuffers()
 // or if there is a difference between your window resolution and framebuffer resolution.
 void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 {
-    for (ImDrawList* draw_list : CmdLists)
-        for (ImDrawCmd& cmd : draw_list->CmdBuffer)
-            cmd.ClipRect = ImVec4(cmd.ClipRect.x * fb_scale.x, cmd.ClipRect.y * fb_scale.y, cmd.ClipRect.z * fb_scale.x, cmd.ClipRect.w * fb_scale.y);
+    ImDrawDataScaleJob data = { this, fb_scale };
+    ImGui::ParallelFor(CmdListsCount, ImDrawData_ScaleClipRectsJob, &data);
+}
+
+static void ImDrawData_ScaleVertexPositionsJob(void* job_data, int n)
+{
+    ImDrawDataScaleJob* data = (ImDrawDataScaleJob*)job_data;
+    ImDrawList* draw_list = data->DrawData->CmdLists[n];
+    ImDrawVert* vtx = draw_list->VtxBuffer.Data;
+    const int vtx_count = draw_list->VtxBuffer.Size;
+    int vtx_n = 0;
+#ifdef IMGUI_ENABLE_SSE
+    // Process two vertices at a time: each 'pos' is loaded into one half of a register (ImDrawVert layout may be overridden, so we cannot assume more contiguity than that).
+    const __m128 scale = _mm_setr_ps(data->Scale.x, data->Scale.y, data->Scale.x, data->Scale.y);
+    for (; vtx_n + 2 <= vtx_count; vtx_n += 2)
+    {
+        __m128 pos = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(void*)&vtx[vtx_n].pos), (const __m64*)(void*)&vtx[vtx_n + 1].pos);
+        pos = _mm_mul_ps(pos, scale);
+        _mm_storel_pi((__m64*)(void*)&vtx[vtx_n].pos, pos);
+        _mm_storeh_pi((__m64*)(void*)&vtx[vtx_n + 1].pos, pos);
+    }
+#endif
+    for (; vtx_n < vtx_count; vtx_n++)
+        vtx[vtx_n].pos = ImVec2(vtx[vtx_n].pos.x * data->Scale.x, vtx[vtx_n].pos.y * data->Scale.y);
+}
+
+// Helper to scale the pos field of each ImDrawVert.
+// Use if you want to apply a scale (e.g. DPI scale) to vertices on the CPU rather than in your projection matrix.
+// Note that this doesn't touch DisplayPos/DisplaySize/ClipRect: scale them accordingly (e.g. with ScaleClipRects()) if needed.
+void ImDrawData::ScaleVertexPositions(const ImVec2& scale)
+{
+    ImDrawDataScaleJob data = { this, scale };
+    ImGui::ParallelFor(CmdListsCount, ImDrawData_ScaleVertexPositionsJob, &data);
+}
+
+struct ImDrawDataForEachJob
+{
+    ImDrawData* DrawData;
+    void        (*Func)(ImDrawList* draw_list, void* user_data);
+    void*       UserData;
+};
+
+static void ImDrawData_ForEachJob(void* job_data, int n)
+{
+    ImDrawDataForEachJob* data = (ImDrawDataForEachJob*)job_data;
+    data->Func(data->DrawData->CmdLists[n], data->UserData);
+}
+
+// Helper to run a custom pass over each ImDrawList, e.g. color-space conversion of ImDrawVert::col.
+// When io.ParallelForFn is set, 'func' may be called concurrently for different draw lists: it should only modify the draw list it is given.
+// If your pass modifies vertex or index counts, TotalVtxCount/TotalIdxCount won't be updated for you.
+void ImDrawData::ForEachDrawList(void (*func)(ImDrawList* draw_list, void* user_data), void* user_data)
+{
+    ImDrawDataForEachJob data = { this, func, user_data };
+    ImGui::ParallelFor(CmdListsCount, ImDrawData_ForEachJob, &data);
 }
 
 //-----------------------------------------------------------------------------
@@ -2383,6 +2506,7 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    SdfSpread = 4;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2409,6 +2533,7 @@ void    ImFontAtlas::ClearInputData()
             font->ConfigData = NULL;
             font->ConfigDataCount = 0;
         }
+    ImFontAtlasBuildDestroyIncrementalData(this);
     ConfigData.clear();
     CustomRects.clear();
     PackIdMouseCursors = PackIdLines = -1;
@@ -2425,14 +2550,17 @@ void    ImFontAtlas::ClearTexData()
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
     TexPixelsUseColors = false;
+    ImFontAtlasBuildDestroyIncrementalData(this);
     // Important: we leave TexReady untouched
 }
 
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasBuildDestroyIncrementalData(this);
     Fonts.clear_delete();
     TexReady = false;
+    BuildCounter++;
 }
 
 void    ImFontAtlas::Clear()
@@ -2506,6 +2634,10 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 
     ImFontAtlasUpdateConfigDataPointers(this);
 
+    // With ImFontAtlasFlags_IncrementalGlyphs, add to the existing texture (modified regions are recorded in TexUpdates[])
+    if (IncrementalData != NULL && ImFontAtlasBuildAddFontIncremental(this, ConfigData.Size - 1))
+        return new_font_cfg.DstFont;
+
     // Invalidate texture
     TexReady = false;
     ClearTexData();
@@ -2616,6 +2748,8 @@ int ImFontAtlas::AddCustomRectRegular(int width, int height)
     r.Width = (unsigned short)width;
     r.Height = (unsigned short)height;
     CustomRects.push_back(r);
+    if (IncrementalData != NULL)
+        ImFontAtlasBuildPackCustomRectIncremental(this, CustomRects.Size - 1);
     return CustomRects.Size - 1; // Return index
 }
 
@@ -2635,9 +2769,23 @@ int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int
     r.GlyphOffset = offset;
     r.Font = font;
     CustomRects.push_back(r);
+    if (IncrementalData != NULL)
+        ImFontAtlasBuildPackCustomRectIncremental(this, CustomRects.Size - 1);
     return CustomRects.Size - 1; // Return index
 }
 
+void ImFontAtlas::AddTexUpdate(int x, int y, int w, int h)
+{
+    IM_ASSERT(x >= 0 && y >= 0 && x + w <= TexWidth && y + h <= TexHeight);
+    if (w <= 0 || h <= 0)
+        return;
+    for (const ImTextureRect& r : TexUpdates) // Skip if already covered, e.g. by the full rectangle recorded when the texture grows
+        if (x >= r.x && y >= r.y && x + w <= r.x + r.w && y + h <= r.y + r.h)
+            return;
+    ImTextureRect rect = { (unsigned short)x, (unsigned short)y, (unsigned short)w, (unsigned short)h };
+    TexUpdates.push_back(rect);
+}
+
 void ImFontAtlas::CalcCustomRectUV(const ImFontAtlasCustomRect* rect, ImVec2* out_uv_min, ImVec2* out_uv_max) const
 {
     IM_ASSERT(TexWidth > 0 && TexHeight > 0);   // Font atlas needs to be built before we can calculate UV coordinates
@@ -2692,8 +2840,16 @@ bool    ImFontAtlas::Build()
 #endif
     }
 
+    // Restore from cache file if it matches our inputs, otherwise build and update it
+    const bool use_cache = (CacheFilename != NULL && (Flags & ImFontAtlasFlags_IncrementalGlyphs) == 0);
+    if (use_cache && LoadCacheFromFile(CacheFilename))
+        return true;
+
     // Build
-    return builder_io->FontBuilder_Build(this);
+    const bool ret = builder_io->FontBuilder_Build(this);
+    if (ret && use_cache)
+        SaveCacheToFile(CacheFilename);
+    return ret;
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -2714,6 +2870,23 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             *data = table[*data];
 }
 
+// Persistent data for ImFontAtlasFlags_IncrementalGlyphs, stored in atlas->IncrementalData between Build() and ClearTexData().
+struct ImFontAtlasGlyphRequest
+{
+    const ImFont*       Font;       // Only identifies the font: glyphs are added to the matching ConfigData[].DstFont
+    ImWchar             Codepoint;
+};
+
+struct ImFontAtlasIncrementalData
+{
+    ImVector<ImFontAtlasGlyphRequest> PendingGlyphs; // Glyphs requested by ImFont::FindGlyph() misses, processed by the next NewFrame()
+    ImGuiStorage        RequestedGlyphs;    // All (font, codepoint) pairs requested so far, including glyphs missing from the font, so each one is only tried once
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    stbtt_pack_context  PackContext;        // Packer state kept alive after Build(), so new glyphs are packed into remaining free space
+    ImVector<stbtt_fontinfo> FontInfos;     // One per atlas->ConfigData[]
+#endif
+};
+
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
@@ -2740,6 +2913,22 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// With ImFontAtlasFlags_IncrementalGlyphs, Build() only rasterize ASCII and candidates for the fallback/ellipsis characters, which BuildLookupTable() resolves upfront.
+static bool ImFontAtlasBuildIsEagerGlyph(const ImFontConfig& cfg, unsigned int codepoint)
+{
+    if (codepoint < 0x80 || codepoint == cfg.EllipsisChar || codepoint == cfg.DstFont->FallbackChar)
+        return true;
+    return codepoint == IM_UNICODE_CODEPOINT_INVALID || codepoint == 0x2026 || codepoint == 0x0085 || codepoint == 0xFF0E;
+}
+
+static bool ImFontAtlasBuildIsGlyphInRanges(const ImWchar* ranges, unsigned int codepoint)
+{
+    for (; ranges[0] && ranges[1]; ranges += 2)
+        if (codepoint >= ranges[0] && codepoint <= ranges[1])
+            return true;
+    return false;
+}
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2752,6 +2941,143 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// A range of glyphs from one source font, measured then rasterized as one job (see ImGui::ParallelFor()).
+// Jobs write to separate glyphs and separate texture rectangles, so they may run concurrently.
+#ifndef IM_FONTATLAS_GLYPHS_PER_JOB
+#define IM_FONTATLAS_GLYPHS_PER_JOB     256
+#endif
+
+struct ImFontBuildGlyphsJob
+{
+    int                 SrcIndex;           // Index into atlas->ConfigData[] and src_tmp_array[]
+    int                 GlyphStart;         // Index into src_tmp.GlyphsList[], src_tmp.Rects[], src_tmp.PackedChars[]
+    int                 GlyphCount;
+    int                 Surface;            // Output of ImFontAtlasBuildGatherRectsJob()
+};
+
+struct ImFontBuildJobsData
+{
+    ImFontAtlas*            Atlas;
+    ImFontBuildSrcData*     SrcTmpArray;
+    ImFontBuildGlyphsJob*   Jobs;
+    const stbtt_pack_context* PackContext;  // Shared packing context. Each job works on its own copy as stbtt_PackFontRangesRenderIntoRects() modifies it.
+};
+
+static float ImFontAtlasBuildCalcScaleForConfig(const stbtt_fontinfo* font_info, const ImFontConfig& cfg)
+{
+    return (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels * cfg.RasterizerDensity);
+}
+
+// Calculate size of the rectangle to pack for a glyph (this is based on stbtt_PackFontRangesGatherRects)
+// With ImFontAtlasFlags_SDF, the glyph bitmap is extended by SdfSpread texels on each side (same as stbtt_GetGlyphSDF()) and oversampling is ignored.
+static void ImFontAtlasBuildCalcGlyphRectSize(const ImFontAtlas* atlas, const stbtt_fontinfo* font_info, const ImFontConfig& cfg, float scale, int glyph_index_in_font, stbrp_rect* r)
+{
+    const int padding = atlas->TexGlyphPadding;
+    int x0, y0, x1, y1;
+    if (atlas->Flags & ImFontAtlasFlags_SDF)
+    {
+        stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale, scale, 0, 0, &x0, &y0, &x1, &y1);
+        const int spread = (x0 != x1 && y0 != y1) ? atlas->SdfSpread : 0; // Empty glyphs have no distance field
+        r->w = (stbrp_coord)(x1 - x0 + spread * 2 + padding);
+        r->h = (stbrp_coord)(y1 - y0 + spread * 2 + padding);
+    }
+    else
+    {
+        stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+        r->w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+        r->h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+    }
+}
+
+// ImFontAtlasFlags_SDF: render distance fields of packed glyphs into atlas->TexPixelsAlpha8 and fill their stbtt_packedchar.
+// This replaces stbtt_PackFontRangesRenderIntoRects(). Texels are 128 on the outline and change by 128/SdfSpread per texel (higher inside).
+static void ImFontAtlasBuildRenderGlyphsSdf(ImFontAtlas* atlas, const stbtt_fontinfo* font_info, float scale, const int* codepoints, int count, const stbrp_rect* rects, stbtt_packedchar* packed_chars)
+{
+    const int padding = atlas->TexGlyphPadding;
+    const int spread = atlas->SdfSpread;
+    for (int glyph_i = 0; glyph_i < count; glyph_i++)
+    {
+        const stbrp_rect& r = rects[glyph_i];
+        if (!r.was_packed)
+            continue;
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(font_info, codepoints[glyph_i]);
+        int advance, lsb;
+        stbtt_GetGlyphHMetrics(font_info, glyph_index_in_font, &advance, &lsb);
+
+        // Glyph is stored after the padding on left and top, same as stbtt_PackFontRangesRenderIntoRects()
+        stbtt_packedchar& pc = packed_chars[glyph_i];
+        int w = 0, h = 0, x_off = 0, y_off = 0;
+        unsigned char* sdf_pixels = stbtt_GetGlyphSDF(font_info, scale, glyph_index_in_font, spread, 128, 128.0f / spread, &w, &h, &x_off, &y_off);
+        if (sdf_pixels != NULL)
+        {
+            IM_ASSERT(w + padding <= r.w && h + padding <= r.h);
+            for (int y = 0; y < h; y++)
+                memcpy(atlas->TexPixelsAlpha8 + (r.y + padding + y) * atlas->TexWidth + r.x + padding, sdf_pixels + y * w, (size_t)w);
+            stbtt_FreeSDF(sdf_pixels, font_info->userdata);
+        }
+        pc.x0 = (unsigned short)(r.x + padding);
+        pc.y0 = (unsigned short)(r.y + padding);
+        pc.x1 = (unsigned short)(r.x + padding + w);
+        pc.y1 = (unsigned short)(r.y + padding + h);
+        pc.xoff = (float)x_off;
+        pc.yoff = (float)y_off;
+        pc.xoff2 = (float)(x_off + w);
+        pc.yoff2 = (float)(y_off + h);
+        pc.xadvance = scale * advance;
+    }
+}
+
+// Gather the sizes of all rectangles we will need to pack
+static void ImFontAtlasBuildGatherRectsJob(void* job_data, int job_n)
+{
+    ImFontBuildJobsData* data = (ImFontBuildJobsData*)job_data;
+    ImFontBuildGlyphsJob& job = data->Jobs[job_n];
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[job.SrcIndex];
+    const ImFontConfig& cfg = data->Atlas->ConfigData[job.SrcIndex];
+    const float scale = ImFontAtlasBuildCalcScaleForConfig(&src_tmp.FontInfo, cfg);
+    for (int glyph_i = job.GlyphStart; glyph_i < job.GlyphStart + job.GlyphCount; glyph_i++)
+    {
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
+        IM_ASSERT(glyph_index_in_font != 0);
+        ImFontAtlasBuildCalcGlyphRectSize(data->Atlas, &src_tmp.FontInfo, cfg, scale, glyph_index_in_font, &src_tmp.Rects[glyph_i]);
+        job.Surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+    }
+}
+
+static void ImFontAtlasBuildRenderGlyphsJob(void* job_data, int job_n)
+{
+    ImFontBuildJobsData* data = (ImFontBuildJobsData*)job_data;
+    const ImFontBuildGlyphsJob& job = data->Jobs[job_n];
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[job.SrcIndex];
+    const ImFontConfig& cfg = data->Atlas->ConfigData[job.SrcIndex];
+    if (data->Atlas->Flags & ImFontAtlasFlags_SDF)
+    {
+        const float scale = ImFontAtlasBuildCalcScaleForConfig(&src_tmp.FontInfo, cfg);
+        ImFontAtlasBuildRenderGlyphsSdf(data->Atlas, &src_tmp.FontInfo, scale, src_tmp.GlyphsList.Data + job.GlyphStart, job.GlyphCount, src_tmp.Rects + job.GlyphStart, src_tmp.PackedChars + job.GlyphStart);
+        return;
+    }
+
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints += job.GlyphStart;
+    pack_range.chardata_for_range += job.GlyphStart;
+    pack_range.num_chars = job.GlyphCount;
+    stbrp_rect* rects = src_tmp.Rects + job.GlyphStart;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        ImFontAtlas* atlas = data->Atlas;
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < job.GlyphCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2814,11 +3140,14 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 2. For every requested codepoint, check for their presence in the font data, and handle redundancy or overlaps between source fonts to avoid unused glyphs.
+    // With ImFontAtlasFlags_IncrementalGlyphs, other glyphs are rasterized on first use by ImFontAtlasBuildUpdatePendingGlyphs().
+    const bool incremental = (atlas->Flags & ImFontAtlasFlags_IncrementalGlyphs) != 0;
     int total_glyphs_count = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         ImFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
         src_tmp.GlyphsSet.Create(src_tmp.GlyphsHighest + 1);
         if (dst_tmp.GlyphsSet.Storage.empty())
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
@@ -2828,6 +3157,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             {
                 if (dst_tmp.GlyphsSet.TestBit(codepoint))    // Don't overwrite existing glyphs. We could make this an option for MergeMode (e.g. MergeOverwrite==true)
                     continue;
+                if (incremental && !ImFontAtlasBuildIsEagerGlyph(cfg, codepoint))
+                    continue;
                 if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))    // It is actually in the font?
                     continue;
 
@@ -2863,6 +3194,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
+    // Measuring and rasterizing (step 8) are split into jobs dispatched through io.ParallelForFn. Packing stays serial so output is identical to a serial build.
+    ImVector<ImFontBuildGlyphsJob> jobs;
     int total_surface = 0;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
@@ -2887,20 +3220,17 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
         src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
 
-        // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
-        const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels * cfg.RasterizerDensity);
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+        // Split glyphs into jobs
+        for (int glyph_start = 0; glyph_start < src_tmp.GlyphsCount; glyph_start += IM_FONTATLAS_GLYPHS_PER_JOB)
         {
-            int x0, y0, x1, y1;
-            const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
-            IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+            ImFontBuildGlyphsJob job = { src_i, glyph_start, ImMin(IM_FONTATLAS_GLYPHS_PER_JOB, src_tmp.GlyphsCount - glyph_start), 0 };
+            jobs.push_back(job);
         }
     }
+    ImFontBuildJobsData jobs_data = { atlas, src_tmp_array.Data, jobs.Data, NULL };
+    ImGui::ParallelFor(jobs.Size, ImFontAtlasBuildGatherRectsJob, &jobs_data);
+    for (const ImFontBuildGlyphsJob& job : jobs)
+        total_surface += job.Surface;
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
@@ -2911,6 +3241,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         atlas->TexWidth = atlas->TexDesiredWidth;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    if (incremental && atlas->TexDesiredWidth <= 0)
+        atlas->TexWidth = ImMax(atlas->TexWidth, 1024); // Leave room for glyphs rasterized later
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
@@ -2944,30 +3276,26 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
-    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
-        {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
-        }
+    jobs_data.PackContext = &spc;
+    ImGui::ParallelFor(jobs.Size, ImFontAtlasBuildRenderGlyphsJob, &jobs_data);
+    for (ImFontBuildSrcData& src_tmp : src_tmp_array)
         src_tmp.Rects = NULL;
-    }
 
     // End packing
-    stbtt_PackEnd(&spc);
+    // (with ImFontAtlasFlags_IncrementalGlyphs we keep the packer and font infos alive to add glyphs later)
+    ImFontAtlasIncrementalData* incremental_data = NULL;
+    if (incremental)
+    {
+        incremental_data = IM_NEW(ImFontAtlasIncrementalData)();
+        incremental_data->PackContext = spc;
+        incremental_data->FontInfos.resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            incremental_data->FontInfos[src_i] = src_tmp_array[src_i].FontInfo;
+    }
+    else
+    {
+        stbtt_PackEnd(&spc);
+    }
     buf_rects.clear();
 
     // 9. Setup ImFont and glyphs for runtime
@@ -3012,9 +3340,305 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     src_tmp_array.clear_destruct();
 
     ImFontAtlasBuildFinish(atlas);
+    atlas->IncrementalData = incremental_data;
     return true;
 }
 
+// Grow texture height, preserving existing pixels. UV coordinates of existing glyphs are rescaled, those of custom rectangles and baked data are recomputed.
+static void ImFontAtlasBuildGrowTexture(ImFontAtlas* atlas, int new_height)
+{
+    const int old_height = atlas->TexHeight;
+    const int width = atlas->TexWidth;
+    IM_ASSERT(new_height > old_height);
+
+    unsigned char* new_pixels = (unsigned char*)IM_ALLOC((size_t)width * new_height);
+    memcpy(new_pixels, atlas->TexPixelsAlpha8, (size_t)width * old_height);
+    memset(new_pixels + (size_t)width * old_height, 0, (size_t)width * (new_height - old_height));
+    IM_FREE(atlas->TexPixelsAlpha8);
+    atlas->TexPixelsAlpha8 = new_pixels;
+    if (atlas->TexPixelsRGBA32)
+    {
+        unsigned int* new_pixels_rgba32 = (unsigned int*)IM_ALLOC((size_t)width * new_height * 4);
+        memcpy(new_pixels_rgba32, atlas->TexPixelsRGBA32, (size_t)width * old_height * 4);
+        for (unsigned int* dst = new_pixels_rgba32 + width * old_height; dst < new_pixels_rgba32 + width * new_height; dst++)
+            *dst = IM_COL32(255, 255, 255, 0);
+        IM_FREE(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = new_pixels_rgba32;
+    }
+    atlas->TexHeight = new_height;
+
+    const float v_scale = (float)old_height / (float)new_height;
+    for (ImFont* font : atlas->Fonts)
+        for (ImFontGlyph& glyph : font->Glyphs)
+        {
+            glyph.V0 *= v_scale;
+            glyph.V1 *= v_scale;
+        }
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+
+    // Recompute UVs derived from custom rectangles from their pixel coordinates (same as ImFontAtlasBuildRenderDefaultTexData(), ImFontAtlasBuildRenderLinesTexData())
+    const ImFontAtlasCustomRect* r = atlas->GetCustomRectByIndex(atlas->PackIdMouseCursors);
+    atlas->TexUvWhitePixel = ImVec2((r->X + 0.5f) * atlas->TexUvScale.x, (r->Y + 0.5f) * atlas->TexUvScale.y);
+    if (!(atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF)))
+    {
+        r = atlas->GetCustomRectByIndex(atlas->PackIdLines);
+        for (unsigned int n = 0; n < IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1; n++)
+            atlas->TexUvLines[n].y = atlas->TexUvLines[n].w = (r->Y + n + 0.5f) * atlas->TexUvScale.y;
+    }
+    for (const ImFontAtlasCustomRect& custom_rect : atlas->CustomRects)
+    {
+        if (custom_rect.Font == NULL || custom_rect.GlyphID == 0 || !custom_rect.IsPacked())
+            continue;
+        const int index_offset = custom_rect.Font->GetIndexOffset((ImWchar)custom_rect.GlyphID);
+        const ImWchar glyph_idx = (index_offset >= 0) ? custom_rect.Font->IndexLookup.Data[index_offset] : (ImWchar)-1;
+        if (glyph_idx == (ImWchar)-1 || custom_rect.Font->Glyphs[glyph_idx].Codepoint != custom_rect.GlyphID)
+            continue;
+        ImFontGlyph& glyph = custom_rect.Font->Glyphs[glyph_idx];
+        ImVec2 uv0, uv1;
+        atlas->CalcCustomRectUV(&custom_rect, &uv0, &uv1);
+        glyph.U0 = uv0.x; glyph.V0 = uv0.y;
+        glyph.U1 = uv1.x; glyph.V1 = uv1.y;
+    }
+
+    // Size changed: backend will need to recreate the whole texture anyway
+    ImTextureRect full_rect = { 0, 0, (unsigned short)width, (unsigned short)new_height };
+    atlas->TexUpdates.resize(0);
+    atlas->TexUpdates.push_back(full_rect);
+}
+
+// Register last glyph of font->Glyphs[] into lookup tables, without a full BuildLookupTable()
+static void ImFontAtlasBuildIndexLastGlyph(ImFont* font)
+{
+    const int glyph_idx = font->Glyphs.Size - 1;
+    const ImFontGlyph& glyph = font->Glyphs[glyph_idx];
+    const int codepoint = (int)glyph.Codepoint;
+    const int index_offset = font->AllocIndexEntry((ImWchar)codepoint); // New pages are initialized from leaf 0, which already uses FallbackAdvanceX
+    font->IndexAdvanceX[index_offset] = glyph.AdvanceX;
+    font->IndexLookup[index_offset] = (ImWchar)glyph_idx;
+    font->ContainerAtlas->BuildCounter++;
+
+    // Mark 4K page as used
+    const int page_n = codepoint / 4096;
+    font->Used4kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+}
+
+static void ImFontAtlasBuildUpdatePendingGlyphsWithStbTruetype(ImFontAtlas* atlas, ImFontAtlasIncrementalData* data)
+{
+    // Assign each request to the first source font providing it (same priority as Build() when merging fonts)
+    ImVector<int> requests_src;
+    requests_src.resize(data->PendingGlyphs.Size);
+    for (int req_i = 0; req_i < data->PendingGlyphs.Size; req_i++)
+    {
+        const ImFontAtlasGlyphRequest& req = data->PendingGlyphs[req_i];
+        requests_src[req_i] = -1;
+        if (req.Font->FindGlyphNoFallback(req.Codepoint) != NULL) // e.g. provided by AddRemapChar() or a custom rectangle
+            continue;
+        for (int src_i = 0; src_i < atlas->ConfigData.Size && requests_src[req_i] == -1; src_i++)
+        {
+            const ImFontConfig& cfg = atlas->ConfigData[src_i];
+            const ImWchar* src_ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault(); // Same fallback as ImFontAtlasBuildWithStbTruetype()
+            if (cfg.DstFont == req.Font && ImFontAtlasBuildIsGlyphInRanges(src_ranges, req.Codepoint) && stbtt_FindGlyphIndex(&data->FontInfos[src_i], req.Codepoint))
+                requests_src[req_i] = src_i;
+        }
+    }
+
+    // Remember fallback glyphs by index as AddGlyph() may reallocate Glyphs[]
+    ImVector<int> fallback_glyph_indices;
+    fallback_glyph_indices.resize(atlas->Fonts.Size);
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        ImFont* font = atlas->Fonts[font_i];
+        fallback_glyph_indices[font_i] = font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1;
+    }
+
+    stbtt_pack_context* spc = &data->PackContext;
+    const bool sdf = (atlas->Flags & ImFontAtlasFlags_SDF) != 0;
+    const int TEX_HEIGHT_MAX = 1024 * 32;
+    int dirty_x0 = INT_MAX, dirty_y0 = INT_MAX, dirty_x1 = 0, dirty_y1 = 0;
+    ImVector<int> codepoints;
+    ImVector<stbrp_rect> rects;
+    ImVector<stbtt_packedchar> packed_chars;
+    for (int src_i = 0; src_i < atlas->ConfigData.Size; src_i++)
+    {
+        codepoints.resize(0);
+        for (int req_i = 0; req_i < data->PendingGlyphs.Size; req_i++)
+            if (requests_src[req_i] == src_i)
+                codepoints.push_back((int)data->PendingGlyphs[req_i].Codepoint);
+        if (codepoints.Size == 0)
+            continue;
+
+        ImFontConfig& cfg = atlas->ConfigData[src_i];
+        stbtt_fontinfo* font_info = &data->FontInfos[src_i];
+        rects.resize(codepoints.Size);
+        packed_chars.resize(codepoints.Size);
+        memset(rects.Data, 0, (size_t)rects.size_in_bytes());
+        memset(packed_chars.Data, 0, (size_t)packed_chars.size_in_bytes());
+
+        // Gather sizes and pack (same as steps 4 and 6 of ImFontAtlasBuildWithStbTruetype())
+        stbtt_pack_range pack_range = {};
+        pack_range.font_size = cfg.SizePixels * cfg.RasterizerDensity;
+        pack_range.array_of_unicode_codepoints = codepoints.Data;
+        pack_range.num_chars = codepoints.Size;
+        pack_range.chardata_for_range = packed_chars.Data;
+        pack_range.h_oversample = (unsigned char)cfg.OversampleH;
+        pack_range.v_oversample = (unsigned char)cfg.OversampleV;
+        const float scale = ImFontAtlasBuildCalcScaleForConfig(font_info, cfg);
+        for (int glyph_i = 0; glyph_i < codepoints.Size; glyph_i++)
+            ImFontAtlasBuildCalcGlyphRectSize(atlas, font_info, cfg, scale, stbtt_FindGlyphIndex(font_info, codepoints[glyph_i]), &rects[glyph_i]);
+        stbrp_pack_rects((stbrp_context*)spc->pack_info, rects.Data, rects.Size);
+
+        // Grow texture if needed. Glyphs which didn't fit within TEX_HEIGHT_MAX are left unpacked and will keep using the fallback glyph.
+        int required_height = atlas->TexHeight;
+        for (const stbrp_rect& r : rects)
+            if (r.was_packed)
+                required_height = ImMax(required_height, r.y + r.h);
+        if (required_height > atlas->TexHeight)
+            ImFontAtlasBuildGrowTexture(atlas, ImMin(ImUpperPowerOfTwo(required_height), TEX_HEIGHT_MAX));
+        spc->pixels = atlas->TexPixelsAlpha8;
+        spc->height = atlas->TexHeight;
+
+        // Rasterize
+        if (sdf)
+            ImFontAtlasBuildRenderGlyphsSdf(atlas, font_info, scale, codepoints.Data, codepoints.Size, rects.Data, packed_chars.Data);
+        else
+            stbtt_PackFontRangesRenderIntoRects(spc, font_info, &pack_range, 1, rects.Data);
+        if (cfg.RasterizerMultiply != 1.0f && !sdf)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            for (const stbrp_rect& r : rects)
+                if (r.was_packed)
+                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r.x, r.y, r.w, r.h, atlas->TexWidth * 1);
+        }
+
+        // Register glyphs (same as step 9 of ImFontAtlasBuildWithStbTruetype())
+        ImFont* dst_font = cfg.DstFont;
+        const float font_off_x = cfg.GlyphOffset.x;
+        const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(dst_font->Ascent);
+        const float inv_rasterization_scale = 1.0f / cfg.RasterizerDensity;
+        for (int glyph_i = 0; glyph_i < codepoints.Size; glyph_i++)
+        {
+            const stbrp_rect& r = rects[glyph_i];
+            if (!r.was_packed || dst_font->Glyphs.Size >= 0xFFFF - 1) // -1 is reserved in IndexLookup[]
+                continue;
+            const stbtt_packedchar& pc = packed_chars[glyph_i];
+            stbtt_aligned_quad q;
+            float unused_x = 0.0f, unused_y = 0.0f;
+            stbtt_GetPackedQuad(packed_chars.Data, atlas->TexWidth, atlas->TexHeight, glyph_i, &unused_x, &unused_y, &q, 0);
+            float x0 = q.x0 * inv_rasterization_scale + font_off_x;
+            float y0 = q.y0 * inv_rasterization_scale + font_off_y;
+            float x1 = q.x1 * inv_rasterization_scale + font_off_x;
+            float y1 = q.y1 * inv_rasterization_scale + font_off_y;
+            dst_font->AddGlyph(&cfg, (ImWchar)codepoints[glyph_i], x0, y0, x1, y1, q.s0, q.t0, q.s1, q.t1, pc.xadvance * inv_rasterization_scale);
+            ImFontAtlasBuildIndexLastGlyph(dst_font);
+
+            dirty_x0 = ImMin(dirty_x0, (int)r.x);
+            dirty_y0 = ImMin(dirty_y0, (int)r.y);
+            dirty_x1 = ImMax(dirty_x1, (int)(r.x + r.w));
+            dirty_y1 = ImMax(dirty_y1, (int)(r.y + r.h));
+        }
+        dst_font->DirtyLookupTables = false;
+    }
+
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+        if (fallback_glyph_indices[font_i] != -1)
+            atlas->Fonts[font_i]->FallbackGlyph = &atlas->Fonts[font_i]->Glyphs[fallback_glyph_indices[font_i]];
+
+    // Record modified region, keep RGBA32 copy in sync
+    if (dirty_x0 >= dirty_x1 || dirty_y0 >= dirty_y1)
+        return;
+    atlas->AddTexUpdate(dirty_x0, dirty_y0, dirty_x1 - dirty_x0, dirty_y1 - dirty_y0);
+    if (atlas->TexPixelsRGBA32)
+        for (int y = dirty_y0; y < dirty_y1; y++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + y * atlas->TexWidth + dirty_x0;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + y * atlas->TexWidth + dirty_x0;
+            for (int n = dirty_x1 - dirty_x0; n > 0; n--)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+}
+
+// Register a source font added after Build() (ConfigData[src_i]). Eager glyphs (ASCII, fallback, ellipsis) are rasterized now, other glyphs on first use.
+static bool ImFontAtlasBuildAddFontIncrementalWithStbTruetype(ImFontAtlas* atlas, ImFontAtlasIncrementalData* data, int src_i)
+{
+    IM_ASSERT(data->FontInfos.Size == src_i);
+    ImFontConfig& cfg = atlas->ConfigData[src_i];
+    stbtt_fontinfo font_info;
+    const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+    if (font_offset < 0 || !stbtt_InitFont(&font_info, (unsigned char*)cfg.FontData, font_offset))
+        return false;
+
+    ImFont* dst_font = cfg.DstFont;
+    if (!cfg.MergeMode)
+    {
+        const float font_scale = stbtt_ScaleForPixelHeight(&font_info, cfg.SizePixels);
+        int unscaled_ascent, unscaled_descent, unscaled_line_gap;
+        stbtt_GetFontVMetrics(&font_info, &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
+        ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ImCeil(unscaled_ascent * font_scale), ImFloor(unscaled_descent * font_scale));
+    }
+    data->FontInfos.push_back(font_info);
+
+    // Glyphs previously found missing may be provided by the new source
+    data->RequestedGlyphs.Clear();
+    for (unsigned int codepoint = 0x20; codepoint < 0x80; codepoint++)
+        ImFontAtlasBuildQueueGlyph(atlas, dst_font, (ImWchar)codepoint);
+    const ImWchar special_chars[] = { cfg.EllipsisChar, dst_font->FallbackChar, (ImWchar)IM_UNICODE_CODEPOINT_INVALID, (ImWchar)0x2026, (ImWchar)0x0085, (ImWchar)0xFF0E };
+    for (ImWchar c : special_chars)
+        if (c != (ImWchar)-1)
+            ImFontAtlasBuildQueueGlyph(atlas, dst_font, c);
+    ImFontAtlasBuildUpdatePendingGlyphsWithStbTruetype(atlas, data);
+    data->PendingGlyphs.resize(0);
+
+    // Setup fallback and ellipsis of a new font (a merged font keeps its own)
+    if (!cfg.MergeMode)
+    {
+        if (dst_font->Glyphs.Size == 0)
+            return false;
+        dst_font->BuildLookupTable();
+    }
+    atlas->BuildCounter++;
+    return true;
+}
+
+// Pack a custom rectangle added after Build() into remaining space, growing the texture if needed.
+// Its pixels are left cleared for the user to render into, and recorded in TexUpdates[] for upload.
+static void ImFontAtlasBuildPackCustomRectIncrementalWithStbTruetype(ImFontAtlas* atlas, ImFontAtlasIncrementalData* data, int rect_index)
+{
+    stbtt_pack_context* spc = &data->PackContext;
+    ImFontAtlasCustomRect* user_rect = &atlas->CustomRects[rect_index];
+    stbrp_rect pack_rect = {};
+    pack_rect.w = (stbrp_coord)(user_rect->Width + spc->padding); // Unlike Build() we pack after glyphs, so we need our own padding
+    pack_rect.h = (stbrp_coord)(user_rect->Height + spc->padding);
+    stbrp_pack_rects((stbrp_context*)spc->pack_info, &pack_rect, 1);
+    if (!pack_rect.was_packed)
+        return;
+
+    const int TEX_HEIGHT_MAX = 1024 * 32;
+    if (pack_rect.y + pack_rect.h > atlas->TexHeight)
+        ImFontAtlasBuildGrowTexture(atlas, ImMin(ImUpperPowerOfTwo(pack_rect.y + pack_rect.h), TEX_HEIGHT_MAX));
+    spc->pixels = atlas->TexPixelsAlpha8;
+    spc->height = atlas->TexHeight;
+    user_rect->X = (unsigned short)pack_rect.x;
+    user_rect->Y = (unsigned short)pack_rect.y;
+    atlas->AddTexUpdate(user_rect->X, user_rect->Y, user_rect->Width, user_rect->Height);
+
+    // Register as glyph (same as ImFontAtlasBuildFinish())
+    if (ImFont* font = user_rect->Font)
+    {
+        if (user_rect->GlyphID == 0 || font->Glyphs.Size >= 0xFFFF - 1)
+            return;
+        IM_ASSERT(font->ContainerAtlas == atlas);
+        const int fallback_glyph_index = font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1; // AddGlyph() may reallocate Glyphs[]
+        ImVec2 uv0, uv1;
+        atlas->CalcCustomRectUV(user_rect, &uv0, &uv1);
+        font->AddGlyph(NULL, (ImWchar)user_rect->GlyphID, user_rect->GlyphOffset.x, user_rect->GlyphOffset.y, user_rect->GlyphOffset.x + user_rect->Width, user_rect->GlyphOffset.y + user_rect->Height, uv0.x, uv0.y, uv1.x, uv1.y, user_rect->GlyphAdvanceX);
+        ImFontAtlasBuildIndexLastGlyph(font);
+        font->DirtyLookupTables = false;
+        if (fallback_glyph_index != -1)
+            font->FallbackGlyph = &font->Glyphs[fallback_glyph_index];
+    }
+}
+
 const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 {
     static ImFontBuilderIO io;
@@ -3024,6 +3648,77 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+// Called by ImFont::FindGlyph() on a miss, when the atlas was built with ImFontAtlasFlags_IncrementalGlyphs
+// The font is never modified here, which is what allows FindGlyph() to stay const: the pending glyph is added to the non-const ConfigData[].DstFont by the next NewFrame().
+void ImFontAtlasBuildQueueGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c)
+{
+    ImFontAtlasIncrementalData* data = (ImFontAtlasIncrementalData*)atlas->IncrementalData;
+    if (data == NULL)
+        return;
+    int* p_requested = data->RequestedGlyphs.GetIntRef(ImHashData(&font, sizeof(font), (ImU32)c), 0);
+    if (*p_requested)
+        return;
+    *p_requested = 1;
+    ImFontAtlasGlyphRequest req = { font, c };
+    data->PendingGlyphs.push_back(req);
+}
+
+// Rasterize glyphs queued by ImFontAtlasBuildQueueGlyph(). Called by NewFrame() before locking the atlas.
+// Modified regions are appended to atlas->TexUpdates[], which the renderer backend needs to upload.
+void ImFontAtlasBuildUpdatePendingGlyphs(ImFontAtlas* atlas)
+{
+    IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasIncrementalData* data = (ImFontAtlasIncrementalData*)atlas->IncrementalData;
+    if (data == NULL || data->PendingGlyphs.Size == 0)
+        return;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    ImFontAtlasBuildUpdatePendingGlyphsWithStbTruetype(atlas, data);
+#endif
+    data->PendingGlyphs.resize(0);
+}
+
+// Called by AddFont() after Build(). Return false if the font can't be added incrementally, in which case the atlas needs to be rebuilt.
+bool ImFontAtlasBuildAddFontIncremental(ImFontAtlas* atlas, int src_i)
+{
+    IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasIncrementalData* data = (ImFontAtlasIncrementalData*)atlas->IncrementalData;
+    if (data == NULL)
+        return false;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    return ImFontAtlasBuildAddFontIncrementalWithStbTruetype(atlas, data, src_i);
+#else
+    IM_UNUSED(src_i);
+    return false;
+#endif
+}
+
+// Called by AddCustomRectRegular()/AddCustomRectFontGlyph() after Build()
+void ImFontAtlasBuildPackCustomRectIncremental(ImFontAtlas* atlas, int rect_index)
+{
+    IM_ASSERT(!atlas->Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasIncrementalData* data = (ImFontAtlasIncrementalData*)atlas->IncrementalData;
+    if (data == NULL)
+        return;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    ImFontAtlasBuildPackCustomRectIncrementalWithStbTruetype(atlas, data, rect_index);
+#else
+    IM_UNUSED(rect_index);
+#endif
+}
+
+void ImFontAtlasBuildDestroyIncrementalData(ImFontAtlas* atlas)
+{
+    ImFontAtlasIncrementalData* data = (ImFontAtlasIncrementalData*)atlas->IncrementalData;
+    if (data == NULL)
+        return;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    stbtt_PackEnd(&data->PackContext);
+#endif
+    IM_DELETE(data);
+    atlas->IncrementalData = NULL;
+    atlas->TexUpdates.clear();
+}
+
 void ImFontAtlasUpdateConfigDataPointers(ImFontAtlas* atlas)
 {
     for (ImFontConfig& font_cfg : atlas->ConfigData)
@@ -3143,7 +3838,7 @@ static void ImFontAtlasBuildRenderDefaultTexData(ImFontAtlas* atlas)
 
 static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
 {
-    if (atlas->Flags & ImFontAtlasFlags_NoBakedLines)
+    if (atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF)) // Anti-aliased edges of baked lines can't go through the distance field shader
         return;
 
     // This generates a triangular shape in the texture, with the various line widths stacked on top of each other to allow interpolation between them
@@ -3215,7 +3910,7 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
     // The +2 here is to give space for the end caps, whilst height +1 is to accommodate the fact we have a zero-width row
     if (atlas->PackIdLines < 0)
     {
-        if (!(atlas->Flags & ImFontAtlasFlags_NoBakedLines))
+        if (!(atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SDF)))
             atlas->PackIdLines = atlas->AddCustomRectRegular(IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 2, IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1);
     }
 }
@@ -3248,6 +3943,7 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             font->BuildLookupTable();
 
     atlas->TexReady = true;
+    atlas->BuildCounter++;
 }
 
 // Retrieve list of range (2 int per range, values are inclusive)
@@ -3312,13 +4008,435 @@ static void UnpackAccumulativeOffsetsIntoRanges(int base_codepoint, const short*
 }
 
 //-------------------------------------------------------------------------
-// [SECTION] ImFontAtlas glyph ranges helpers
+// [SECTION] ImFontAtlas cache
+//-------------------------------------------------------------------------
+// Binary snapshot of ImFontAtlas::Build() output, so a matching atlas can be restored without rasterizing anything.
+// Layout:
+// - ImFontAtlasCacheHeader
+// - ImFontAtlasCacheRect[CustomRectsCount]
+// - Texture pixels: Alpha8 (TexWidth * TexHeight bytes) and/or RGBA32 (TexWidth * TexHeight * 4 bytes)
+// - For each font: ImFontAtlasCacheFont, ImFontGlyph[GlyphsCount], ImU16[IndexPagesCount], float[IndexAdvanceXCount], ImWchar[IndexLookupCount]
+// Structures are stored raw: cache files are not meant to be portable, the Key field rejects files written by a different build or from different inputs.
 //-------------------------------------------------------------------------
 
-const ImWchar*  ImFontAtlas::GetGlyphRangesChineseSimplifiedCommon()
+#define IM_FONTATLAS_CACHE_MAGIC    0x41464D49  // "IMFA"
+#define IM_FONTATLAS_CACHE_VERSION  1
+
+enum ImFontAtlasCacheTexFlags_
 {
-    // Store 2500 regularly used characters for Simplified Chinese.
-    // Sourced from https://zh.wiktionary.org/wiki/%E9%99%84%E5%BD%95:%E7%8E%B0%E4%BB%A3%E6%B1%89%E8%AF%AD%E5%B8%B8%E7%94%A8%E5%AD%97%E8%A1%A8
+    ImFontAtlasCacheTexFlags_HasAlpha8  = 1 << 0,
+    ImFontAtlasCacheTexFlags_HasRGBA32  = 1 << 1,
+    ImFontAtlasCacheTexFlags_UseColors  = 1 << 2,
+};
+
+struct ImFontAtlasCacheHeader
+{
+    ImU32       Magic;
+    ImU32       Version;
+    ImGuiID     Key;                // Hash of build configuration + all atlas inputs, see ImFontAtlasCacheCalcKey()
+    int         TexWidth, TexHeight;
+    int         TexFlags;           // ImFontAtlasCacheTexFlags_
+    ImVec2      TexUvScale;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+    int         PackIdMouseCursors;
+    int         PackIdLines;
+    int         CustomRectsCount;
+    int         FontsCount;
+};
+
+struct ImFontAtlasCacheRect
+{
+    unsigned short  Width, Height;
+    unsigned short  X, Y;
+    unsigned int    GlyphID;
+    float           GlyphAdvanceX;
+    ImVec2          GlyphOffset;
+    int             FontIndex;      // Index in atlas->Fonts[], -1 if none
+};
+
+struct ImFontAtlasCacheFont
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    float       FallbackAdvanceX;
+    float       EllipsisWidth;
+    float       EllipsisCharStep;
+    int         MetricsTotalSurface;
+    int         FallbackGlyphIndex; // Index in Glyphs[], -1 if none
+    int         GlyphsCount;
+    int         IndexPagesCount;
+    int         IndexAdvanceXCount;
+    int         IndexLookupCount;
+    ImWchar     FallbackChar;
+    ImWchar     EllipsisChar;
+    short       EllipsisCharCount;
+    ImU8        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8];
+};
+
+// Hash everything which may affect the output of Build(). Must be called with the same result before and after building,
+// so we skip the custom rectangles which are registered by the builder itself.
+static ImGuiID ImFontAtlasCacheCalcKey(ImFontAtlas* atlas)
+{
+    struct { int CacheVersion, ImGuiVersion, SizeofImWchar, SizeofGlyph, SizeofCacheFont, Builder, Flags, TexDesiredWidth, TexGlyphPadding, SdfSpread; unsigned int FontBuilderFlags; } build_info;
+    memset(&build_info, 0, sizeof(build_info));
+    build_info.CacheVersion = IM_FONTATLAS_CACHE_VERSION;
+    build_info.ImGuiVersion = IMGUI_VERSION_NUM;
+    build_info.SizeofImWchar = (int)sizeof(ImWchar);
+    build_info.SizeofGlyph = (int)sizeof(ImFontGlyph);
+    build_info.SizeofCacheFont = (int)sizeof(ImFontAtlasCacheFont);
+#ifdef IMGUI_ENABLE_FREETYPE
+    build_info.Builder = 1;
+#endif
+    if (atlas->FontBuilderIO != NULL)
+        build_info.Builder |= 2; // We can't identify a custom builder across runs, at least don't confuse it with the default one.
+    build_info.Flags = atlas->Flags;
+    build_info.TexDesiredWidth = atlas->TexDesiredWidth;
+    build_info.TexGlyphPadding = atlas->TexGlyphPadding;
+    build_info.SdfSpread = (atlas->Flags & ImFontAtlasFlags_SDF) ? atlas->SdfSpread : 0;
+    build_info.FontBuilderFlags = atlas->FontBuilderFlags;
+    ImGuiID key = ImHashData(&build_info, sizeof(build_info));
+
+    for (const ImFontConfig& cfg : atlas->ConfigData)
+    {
+        struct { int FontDataSize, FontNo, OversampleH, OversampleV, PixelSnapH, MergeMode, DstFontIndex, EllipsisChar; unsigned int FontBuilderFlags; float SizePixels, GlyphMinAdvanceX, GlyphMaxAdvanceX, RasterizerMultiply, RasterizerDensity; ImVec2 GlyphExtraSpacing, GlyphOffset; } cfg_info;
+        memset(&cfg_info, 0, sizeof(cfg_info));
+        cfg_info.FontDataSize = cfg.FontDataSize;
+        cfg_info.FontNo = cfg.FontNo;
+        cfg_info.OversampleH = cfg.OversampleH;
+        cfg_info.OversampleV = cfg.OversampleV;
+        cfg_info.PixelSnapH = cfg.PixelSnapH;
+        cfg_info.MergeMode = cfg.MergeMode;
+        cfg_info.DstFontIndex = atlas->Fonts.find_index(cfg.DstFont);
+        cfg_info.EllipsisChar = (int)cfg.EllipsisChar;
+        cfg_info.FontBuilderFlags = cfg.FontBuilderFlags;
+        cfg_info.SizePixels = cfg.SizePixels;
+        cfg_info.GlyphMinAdvanceX = cfg.GlyphMinAdvanceX;
+        cfg_info.GlyphMaxAdvanceX = cfg.GlyphMaxAdvanceX;
+        cfg_info.RasterizerMultiply = cfg.RasterizerMultiply;
+        cfg_info.RasterizerDensity = cfg.RasterizerDensity;
+        cfg_info.GlyphExtraSpacing = cfg.GlyphExtraSpacing;
+        cfg_info.GlyphOffset = cfg.GlyphOffset;
+        key = ImHashData(&cfg_info, sizeof(cfg_info), key);
+        key = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, key);
+        if (cfg.GlyphRanges != NULL)
+        {
+            int ranges_count = 0;
+            while (cfg.GlyphRanges[ranges_count] != 0)
+                ranges_count++;
+            key = ImHashData(cfg.GlyphRanges, sizeof(ImWchar) * (ranges_count + 1), key);
+        }
+    }
+
+    for (int rect_n = 0; rect_n < atlas->CustomRects.Size; rect_n++)
+    {
+        if (rect_n == atlas->PackIdMouseCursors || rect_n == atlas->PackIdLines)
+            continue;
+        const ImFontAtlasCustomRect& r = atlas->CustomRects[rect_n];
+        ImFontAtlasCacheRect rect_info;
+        memset(&rect_info, 0, sizeof(rect_info));
+        rect_info.Width = r.Width;
+        rect_info.Height = r.Height;
+        rect_info.GlyphID = r.GlyphID;
+        rect_info.GlyphAdvanceX = r.GlyphAdvanceX;
+        rect_info.GlyphOffset = r.GlyphOffset;
+        rect_info.FontIndex = atlas->Fonts.find_index(r.Font);
+        key = ImHashData(&rect_info, sizeof(rect_info), key);
+    }
+    return key;
+}
+
+// Every block is padded to 4 bytes so structures can be read in place.
+static void ImFontAtlasCacheWrite(ImVector<unsigned char>* buf, const void* data, size_t data_size)
+{
+    const int off = buf->Size;
+    buf->resize(off + (int)IM_MEMALIGN(data_size, 4));
+    memset(buf->Data + off, 0, buf->Size - off);
+    if (data_size > 0)
+        memcpy(buf->Data + off, data, data_size);
+}
+
+// Return a pointer to the next 'data_size' bytes within the cache data, or NULL if truncated.
+static const void* ImFontAtlasCacheRead(const unsigned char** p, const unsigned char* p_end, size_t data_size)
+{
+    data_size = IM_MEMALIGN(data_size, 4);
+    if ((size_t)(p_end - *p) < data_size)
+        return NULL;
+    const void* data = *p;
+    *p += data_size;
+    return data;
+}
+
+bool ImFontAtlas::SaveCacheToMemory(ImVector<unsigned char>* out_data)
+{
+    IM_ASSERT(out_data != NULL);
+    out_data->resize(0);
+    if (!TexReady || (TexPixelsAlpha8 == NULL && TexPixelsRGBA32 == NULL) || IncrementalData != NULL)
+        return false;
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = IM_FONTATLAS_CACHE_MAGIC;
+    header.Version = IM_FONTATLAS_CACHE_VERSION;
+    header.Key = ImFontAtlasCacheCalcKey(this);
+    header.TexWidth = TexWidth;
+    header.TexHeight = TexHeight;
+    header.TexFlags = (TexPixelsAlpha8 ? ImFontAtlasCacheTexFlags_HasAlpha8 : 0) | (TexPixelsRGBA32 ? ImFontAtlasCacheTexFlags_HasRGBA32 : 0) | (TexPixelsUseColors ? ImFontAtlasCacheTexFlags_UseColors : 0);
+    header.TexUvScale = TexUvScale;
+    header.TexUvWhitePixel = TexUvWhitePixel;
+    memcpy(header.TexUvLines, TexUvLines, sizeof(TexUvLines));
+    header.PackIdMouseCursors = PackIdMouseCursors;
+    header.PackIdLines = PackIdLines;
+    header.CustomRectsCount = CustomRects.Size;
+    header.FontsCount = Fonts.Size;
+
+    const size_t tex_pixels_count = (size_t)TexWidth * (size_t)TexHeight;
+    out_data->reserve((int)(sizeof(header) + IM_MEMALIGN(tex_pixels_count, 4) * ((TexPixelsAlpha8 ? 1 : 0) + (TexPixelsRGBA32 ? 4 : 0))));
+    ImFontAtlasCacheWrite(out_data, &header, sizeof(header));
+    for (const ImFontAtlasCustomRect& r : CustomRects)
+    {
+        ImFontAtlasCacheRect rect_info;
+        memset(&rect_info, 0, sizeof(rect_info));
+        rect_info.Width = r.Width;
+        rect_info.Height = r.Height;
+        rect_info.X = r.X;
+        rect_info.Y = r.Y;
+        rect_info.GlyphID = r.GlyphID;
+        rect_info.GlyphAdvanceX = r.GlyphAdvanceX;
+        rect_info.GlyphOffset = r.GlyphOffset;
+        rect_info.FontIndex = Fonts.find_index(r.Font);
+        ImFontAtlasCacheWrite(out_data, &rect_info, sizeof(rect_info));
+    }
+    if (TexPixelsAlpha8)
+        ImFontAtlasCacheWrite(out_data, TexPixelsAlpha8, tex_pixels_count);
+    if (TexPixelsRGBA32)
+        ImFontAtlasCacheWrite(out_data, TexPixelsRGBA32, tex_pixels_count * 4);
+
+    for (const ImFont* font : Fonts)
+    {
+        ImFontAtlasCacheFont font_info;
+        memset(&font_info, 0, sizeof(font_info));
+        font_info.FontSize = font->FontSize;
+        font_info.Ascent = font->Ascent;
+        font_info.Descent = font->Descent;
+        font_info.FallbackAdvanceX = font->FallbackAdvanceX;
+        font_info.EllipsisWidth = font->EllipsisWidth;
+        font_info.EllipsisCharStep = font->EllipsisCharStep;
+        font_info.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_info.FallbackGlyphIndex = font->FallbackGlyph ? (int)font->Glyphs.index_from_ptr(font->FallbackGlyph) : -1;
+        font_info.GlyphsCount = font->Glyphs.Size;
+        font_info.IndexPagesCount = font->IndexPages.Size;
+        font_info.IndexAdvanceXCount = font->IndexAdvanceX.Size;
+        font_info.IndexLookupCount = font->IndexLookup.Size;
+        font_info.FallbackChar = font->FallbackChar;
+        font_info.EllipsisChar = font->EllipsisChar;
+        font_info.EllipsisCharCount = font->EllipsisCharCount;
+        memcpy(font_info.Used4kPagesMap, font->Used4kPagesMap, sizeof(font_info.Used4kPagesMap));
+        ImFontAtlasCacheWrite(out_data, &font_info, sizeof(font_info));
+        ImFontAtlasCacheWrite(out_data, font->Glyphs.Data, font->Glyphs.size_in_bytes());
+        ImFontAtlasCacheWrite(out_data, font->IndexPages.Data, font->IndexPages.size_in_bytes());
+        ImFontAtlasCacheWrite(out_data, font->IndexAdvanceX.Data, font->IndexAdvanceX.size_in_bytes());
+        ImFontAtlasCacheWrite(out_data, font->IndexLookup.Data, font->IndexLookup.size_in_bytes());
+    }
+    return true;
+}
+
+bool ImFontAtlas::SaveCacheToFile(const char* filename)
+{
+    ImVector<unsigned char> data;
+    if (!SaveCacheToMemory(&data))
+        return false;
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const bool ret = ImFileWrite(data.Data, 1, (ImU64)data.Size, f) == (ImU64)data.Size;
+    ImFileClose(f);
+    return ret;
+}
+
+// Texture coordinates must lie within the texture. Written so NaN values are rejected.
+static inline bool ImFontAtlasCacheIsUvValid(float u, float v)
+{
+    return u >= 0.0f && u <= 1.0f && v >= 0.0f && v <= 1.0f;
+}
+
+// Positions must be finite. Written so NaN values are rejected.
+static inline bool ImFontAtlasCacheIsPosValid(float v)
+{
+    return v >= -FLT_MAX && v <= FLT_MAX;
+}
+
+// Parse and validate all the data first, only then replace atlas contents: a stale, truncated or corrupted cache leaves the atlas untouched.
+// Every index and texture coordinate is checked, as they are used without bound checks when rendering.
+bool ImFontAtlas::LoadCacheFromMemory(const void* data, size_t data_size)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    const unsigned char* p = (const unsigned char*)data;
+    const unsigned char* p_end = p + data_size;
+
+    // Header
+    const ImFontAtlasCacheHeader* header = (const ImFontAtlasCacheHeader*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontAtlasCacheHeader));
+    if (header == NULL || header->Magic != IM_FONTATLAS_CACHE_MAGIC || header->Version != IM_FONTATLAS_CACHE_VERSION)
+        return false;
+    if (header->FontsCount != Fonts.Size || header->FontsCount == 0 || header->CustomRectsCount < 0 || header->TexWidth <= 0 || header->TexHeight <= 0 || header->TexWidth > 0x10000 || header->TexHeight > 0x10000)
+        return false;
+    if (header->PackIdMouseCursors < -1 || header->PackIdMouseCursors >= header->CustomRectsCount || header->PackIdLines < -1 || header->PackIdLines >= header->CustomRectsCount)
+        return false;
+    if (!ImFontAtlasCacheIsUvValid(header->TexUvWhitePixel.x, header->TexUvWhitePixel.y))
+        return false;
+    for (const ImVec4& uv : header->TexUvLines)
+        if (!ImFontAtlasCacheIsUvValid(uv.x, uv.y) || !ImFontAtlasCacheIsUvValid(uv.z, uv.w))
+            return false;
+    if ((header->TexFlags & (ImFontAtlasCacheTexFlags_HasAlpha8 | ImFontAtlasCacheTexFlags_HasRGBA32)) == 0)
+        return false;
+    if (header->Key != ImFontAtlasCacheCalcKey(this))
+        return false;
+
+    // Custom rectangles, texture
+    const size_t tex_pixels_count = (size_t)header->TexWidth * (size_t)header->TexHeight;
+    const ImFontAtlasCacheRect* rects = (const ImFontAtlasCacheRect*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontAtlasCacheRect) * header->CustomRectsCount);
+    const void* pixels_alpha8 = (header->TexFlags & ImFontAtlasCacheTexFlags_HasAlpha8) ? ImFontAtlasCacheRead(&p, p_end, tex_pixels_count) : NULL;
+    const void* pixels_rgba32 = (header->TexFlags & ImFontAtlasCacheTexFlags_HasRGBA32) ? ImFontAtlasCacheRead(&p, p_end, tex_pixels_count * 4) : NULL;
+    if (rects == NULL || (pixels_alpha8 == NULL && pixels_rgba32 == NULL))
+        return false;
+    if (((header->TexFlags & ImFontAtlasCacheTexFlags_HasAlpha8) && pixels_alpha8 == NULL) || ((header->TexFlags & ImFontAtlasCacheTexFlags_HasRGBA32) && pixels_rgba32 == NULL))
+        return false;
+    for (int rect_n = 0; rect_n < header->CustomRectsCount; rect_n++)
+    {
+        const ImFontAtlasCacheRect& rect_info = rects[rect_n];
+        if (rect_info.FontIndex < -1 || rect_info.FontIndex >= Fonts.Size)
+            return false;
+        if (rect_info.X != 0xFFFF && ((int)rect_info.X + rect_info.Width > header->TexWidth || (int)rect_info.Y + rect_info.Height > header->TexHeight)) // Packed rectangles only
+            return false;
+    }
+
+    // Fonts
+    const unsigned char* fonts_data = p;
+    for (int font_n = 0; font_n < header->FontsCount; font_n++)
+    {
+        const ImFontAtlasCacheFont* font_info = (const ImFontAtlasCacheFont*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontAtlasCacheFont));
+        if (font_info == NULL || font_info->GlyphsCount < 0 || font_info->IndexPagesCount < 0 || font_info->IndexAdvanceXCount < 0 || font_info->IndexLookupCount != font_info->IndexAdvanceXCount || font_info->FallbackGlyphIndex < -1 || font_info->FallbackGlyphIndex >= font_info->GlyphsCount)
+            return false;
+        if ((font_info->IndexLookupCount & (IM_FONT_INDEX_PAGE_SIZE - 1)) != 0 || font_info->GlyphsCount >= 0xFFFF) // Whole leaves only. (ImWchar)-1 is reserved in IndexLookup[]
+            return false;
+        if (font_info->EllipsisCharCount < 0 || font_info->EllipsisCharCount > 3)
+            return false;
+        const ImFontGlyph* glyphs = (const ImFontGlyph*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontGlyph) * font_info->GlyphsCount);
+        if (glyphs == NULL)
+            return false;
+        for (int glyph_n = 0; glyph_n < font_info->GlyphsCount; glyph_n++)
+        {
+            const ImFontGlyph& glyph = glyphs[glyph_n];
+            if (!ImFontAtlasCacheIsUvValid(glyph.U0, glyph.V0) || !ImFontAtlasCacheIsUvValid(glyph.U1, glyph.V1))
+                return false;
+            if (!ImFontAtlasCacheIsPosValid(glyph.X0) || !ImFontAtlasCacheIsPosValid(glyph.Y0) || !ImFontAtlasCacheIsPosValid(glyph.X1) || !ImFontAtlasCacheIsPosValid(glyph.Y1) || !ImFontAtlasCacheIsPosValid(glyph.AdvanceX))
+                return false;
+        }
+        const ImU16* index_pages = (const ImU16*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImU16) * font_info->IndexPagesCount);
+        if (index_pages == NULL)
+            return false;
+        for (int page_n = 0; page_n < font_info->IndexPagesCount; page_n++)
+            if (((int)index_pages[page_n] << IM_FONT_INDEX_PAGE_SHIFT) >= font_info->IndexLookupCount)
+                return false;
+        if (ImFontAtlasCacheRead(&p, p_end, sizeof(float) * font_info->IndexAdvanceXCount) == NULL)
+            return false;
+        const ImWchar* index_lookup = (const ImWchar*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImWchar) * font_info->IndexLookupCount);
+        if (index_lookup == NULL)
+            return false;
+        for (int lookup_n = 0; lookup_n < font_info->IndexLookupCount; lookup_n++)
+            if (index_lookup[lookup_n] != (ImWchar)-1 && (int)index_lookup[lookup_n] >= font_info->GlyphsCount)
+                return false;
+    }
+
+    // Apply
+    ClearTexData();
+    TexID = (ImTextureID)NULL;
+    TexWidth = header->TexWidth;
+    TexHeight = header->TexHeight;
+    TexUvScale = header->TexUvScale;
+    TexUvWhitePixel = header->TexUvWhitePixel;
+    memcpy(TexUvLines, header->TexUvLines, sizeof(TexUvLines));
+    TexPixelsUseColors = (header->TexFlags & ImFontAtlasCacheTexFlags_UseColors) != 0;
+    if (pixels_alpha8)
+    {
+        TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(tex_pixels_count);
+        memcpy(TexPixelsAlpha8, pixels_alpha8, tex_pixels_count);
+    }
+    if (pixels_rgba32)
+    {
+        TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(tex_pixels_count * 4);
+        memcpy(TexPixelsRGBA32, pixels_rgba32, tex_pixels_count * 4);
+    }
+
+    CustomRects.resize(header->CustomRectsCount);
+    for (int rect_n = 0; rect_n < header->CustomRectsCount; rect_n++)
+    {
+        const ImFontAtlasCacheRect& rect_info = rects[rect_n];
+        ImFontAtlasCustomRect& r = CustomRects[rect_n];
+        r.Width = rect_info.Width;
+        r.Height = rect_info.Height;
+        r.X = rect_info.X;
+        r.Y = rect_info.Y;
+        r.GlyphID = rect_info.GlyphID;
+        r.GlyphAdvanceX = rect_info.GlyphAdvanceX;
+        r.GlyphOffset = rect_info.GlyphOffset;
+        r.Font = (rect_info.FontIndex >= 0) ? Fonts[rect_info.FontIndex] : NULL;
+    }
+    PackIdMouseCursors = header->PackIdMouseCursors;
+    PackIdLines = header->PackIdLines;
+
+    p = fonts_data;
+    for (ImFont* font : Fonts)
+    {
+        const ImFontAtlasCacheFont* font_info = (const ImFontAtlasCacheFont*)ImFontAtlasCacheRead(&p, p_end, sizeof(ImFontAtlasCacheFont));
+        font->ClearOutputData();
+        font->Glyphs.resize(font_info->GlyphsCount);
+        font->IndexPages.resize(font_info->IndexPagesCount);
+        font->IndexAdvanceX.resize(font_info->IndexAdvanceXCount);
+        font->IndexLookup.resize(font_info->IndexLookupCount);
+        memcpy(font->Glyphs.Data, ImFontAtlasCacheRead(&p, p_end, font->Glyphs.size_in_bytes()), font->Glyphs.size_in_bytes());
+        memcpy(font->IndexPages.Data, ImFontAtlasCacheRead(&p, p_end, font->IndexPages.size_in_bytes()), font->IndexPages.size_in_bytes());
+        memcpy(font->IndexAdvanceX.Data, ImFontAtlasCacheRead(&p, p_end, font->IndexAdvanceX.size_in_bytes()), font->IndexAdvanceX.size_in_bytes());
+        memcpy(font->IndexLookup.Data, ImFontAtlasCacheRead(&p, p_end, font->IndexLookup.size_in_bytes()), font->IndexLookup.size_in_bytes());
+        font->FontSize = font_info->FontSize;
+        font->Ascent = font_info->Ascent;
+        font->Descent = font_info->Descent;
+        font->FallbackAdvanceX = font_info->FallbackAdvanceX;
+        font->EllipsisWidth = font_info->EllipsisWidth;
+        font->EllipsisCharStep = font_info->EllipsisCharStep;
+        font->MetricsTotalSurface = font_info->MetricsTotalSurface;
+        font->FallbackGlyph = (font_info->FallbackGlyphIndex >= 0) ? &font->Glyphs[font_info->FallbackGlyphIndex] : NULL;
+        font->FallbackChar = font_info->FallbackChar;
+        font->EllipsisChar = font_info->EllipsisChar;
+        font->EllipsisCharCount = font_info->EllipsisCharCount;
+        memcpy(font->Used4kPagesMap, font_info->Used4kPagesMap, sizeof(font->Used4kPagesMap));
+        font->ContainerAtlas = this;
+        font->DirtyLookupTables = false;
+    }
+    TexReady = true;
+    BuildCounter++;
+    return true;
+}
+
+bool ImFontAtlas::LoadCacheFromFile(const char* filename)
+{
+    size_t data_size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &data_size);
+    if (!data)
+        return false;
+    const bool ret = LoadCacheFromMemory(data, data_size);
+    IM_FREE(data);
+    return ret;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas glyph ranges helpers
+//-------------------------------------------------------------------------
+
+const ImWchar*  ImFontAtlas::GetGlyphRangesChineseSimplifiedCommon()
+{
+    // Store 2500 regularly used characters for Simplified Chinese.
+    // Sourced from https://zh.wiktionary.org/wiki/%E9%99%84%E5%BD%95:%E7%8E%B0%E4%BB%A3%E6%B1%89%E8%AF%AD%E5%B8%B8%E7%94%A8%E5%AD%97%E8%A1%A8
     // This table covers 97.97% of all characters used during the month in July, 1987.
     // You can use ImFontGlyphRangesBuilder to create your own ranges derived from this, by merging existing ranges or adding new characters.
     // (Stored as accumulative offsets from the initial unicode codepoint 0x4E00. This encoding is designed to helps us compact the source code size.)
@@ -3586,6 +4704,7 @@ void    ImFont::ClearOutputData()
     FontSize = 0.0f;
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
+    IndexPages.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     FallbackGlyph = NULL;
@@ -3612,6 +4731,7 @@ void ImFont::BuildLookupTable()
     // Build lookup table
     IM_ASSERT(Glyphs.Size > 0 && "Font has not loaded glyph!");
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    IndexPages.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
     DirtyLookupTables = false;
@@ -3620,8 +4740,9 @@ void ImFont::BuildLookupTable()
     for (int i = 0; i < Glyphs.Size; i++)
     {
         int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (ImWchar)i;
+        const int index_offset = AllocIndexEntry((ImWchar)codepoint);
+        IndexAdvanceX[index_offset] = Glyphs[i].AdvanceX;
+        IndexLookup[index_offset] = (ImWchar)i;
 
         // Mark 4K page as used
         const int page_n = codepoint / 4096;
@@ -3638,8 +4759,9 @@ void ImFont::BuildLookupTable()
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= IM_TABSIZE;
-        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)(Glyphs.Size - 1);
+        const int index_offset = AllocIndexEntry((ImWchar)tab_glyph.Codepoint);
+        IndexAdvanceX[index_offset] = (float)tab_glyph.AdvanceX;
+        IndexLookup[index_offset] = (ImWchar)(Glyphs.Size - 1);
     }
 
     // Mark special glyphs as not visible (note that AddGlyph already mark as non-visible glyphs with zero-size polygons)
@@ -3660,7 +4782,7 @@ void ImFont::BuildLookupTable()
         }
     }
     FallbackAdvanceX = FallbackGlyph->AdvanceX;
-    for (int i = 0; i < max_codepoint + 1; i++)
+    for (int i = 0; i < IndexAdvanceX.Size; i++) // Includes leaf 0 shared by unused pages
         if (IndexAdvanceX[i] < 0.0f)
             IndexAdvanceX[i] = FallbackAdvanceX;
 
@@ -3672,17 +4794,19 @@ void ImFont::BuildLookupTable()
     if (EllipsisChar == (ImWchar)-1)
         EllipsisChar = FindFirstExistingGlyph(this, ellipsis_chars, IM_ARRAYSIZE(ellipsis_chars));
     const ImWchar dot_char = FindFirstExistingGlyph(this, dots_chars, IM_ARRAYSIZE(dots_chars));
+    // With ImFontAtlasFlags_SDF, glyph quads are extended by the distance field spread on each side
+    const float sdf_margin = (ContainerAtlas && (ContainerAtlas->Flags & ImFontAtlasFlags_SDF) && ConfigData) ? ContainerAtlas->SdfSpread / ConfigData->RasterizerDensity : 0.0f;
     if (EllipsisChar != (ImWchar)-1)
     {
         EllipsisCharCount = 1;
-        EllipsisWidth = EllipsisCharStep = FindGlyph(EllipsisChar)->X1;
+        EllipsisWidth = EllipsisCharStep = FindGlyph(EllipsisChar)->X1 - sdf_margin;
     }
     else if (dot_char != (ImWchar)-1)
     {
         const ImFontGlyph* glyph = FindGlyph(dot_char);
         EllipsisChar = dot_char;
         EllipsisCharCount = 3;
-        EllipsisCharStep = (glyph->X1 - glyph->X0) + 1.0f;
+        EllipsisCharStep = (glyph->X1 - glyph->X0 - sdf_margin * 2.0f) + 1.0f;
         EllipsisWidth = EllipsisCharStep * 3.0f - 1.0f;
     }
 }
@@ -3706,13 +4830,37 @@ void ImFont::SetGlyphVisible(ImWchar c, bool visible)
         glyph->Visible = visible ? 1 : 0;
 }
 
+// Grow top level of the paged index to cover code-points [0, new_size). New pages point to empty leaf 0.
 void ImFont::GrowIndex(int new_size)
 {
     IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
-    if (new_size <= IndexLookup.Size)
-        return;
-    IndexAdvanceX.resize(new_size, -1.0f);
-    IndexLookup.resize(new_size, (ImWchar)-1);
+    if (IndexLookup.Size == 0)
+    {
+        IndexAdvanceX.resize(IM_FONT_INDEX_PAGE_SIZE, -1.0f);
+        IndexLookup.resize(IM_FONT_INDEX_PAGE_SIZE, (ImWchar)-1);
+    }
+    const int new_pages_count = (new_size + IM_FONT_INDEX_PAGE_SIZE - 1) >> IM_FONT_INDEX_PAGE_SHIFT;
+    if (new_pages_count > IndexPages.Size)
+        IndexPages.resize(new_pages_count, (ImU16)0);
+}
+
+// Return offset of 'c' in IndexLookup[]/IndexAdvanceX[], allocating its leaf if needed.
+// A new leaf is copied from leaf 0: lookup entries are empty and advances are -1.0f during BuildLookupTable(), FallbackAdvanceX after.
+int ImFont::AllocIndexEntry(ImWchar c)
+{
+    GrowIndex((int)c + 1);
+    const unsigned int page_n = (unsigned int)c >> IM_FONT_INDEX_PAGE_SHIFT;
+    if (IndexPages.Data[page_n] == 0)
+    {
+        const int leaf_n = IndexLookup.Size >> IM_FONT_INDEX_PAGE_SHIFT;
+        IM_ASSERT(leaf_n <= 0xFFFF);
+        IndexAdvanceX.resize(IndexAdvanceX.Size + IM_FONT_INDEX_PAGE_SIZE);
+        IndexLookup.resize(IndexLookup.Size + IM_FONT_INDEX_PAGE_SIZE);
+        memcpy(&IndexAdvanceX.Data[leaf_n << IM_FONT_INDEX_PAGE_SHIFT], &IndexAdvanceX.Data[0], sizeof(float) * IM_FONT_INDEX_PAGE_SIZE);
+        memcpy(&IndexLookup.Data[leaf_n << IM_FONT_INDEX_PAGE_SHIFT], &IndexLookup.Data[0], sizeof(ImWchar) * IM_FONT_INDEX_PAGE_SIZE);
+        IndexPages.Data[page_n] = (ImU16)leaf_n;
+    }
+    return GetIndexOffset(c);
 }
 
 // x0/y0/x1/y1 are offset from the character upper-left layout position, in pixels. Therefore x0/y0 are often fairly close to zero.
@@ -3765,38 +4913,60 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    unsigned int index_size = (unsigned int)IndexLookup.Size;
+    const int src_offset = GetIndexOffset(src);
+    const int dst_offset = GetIndexOffset(dst);
 
-    if (dst < index_size && IndexLookup.Data[dst] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_offset >= 0 && IndexLookup.Data[dst_offset] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (src_offset < 0 && dst_offset < 0) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    const ImWchar src_lookup = (src_offset >= 0) ? IndexLookup.Data[src_offset] : (ImWchar)-1;
+    const float src_advance_x = (src_offset >= 0) ? IndexAdvanceX.Data[src_offset] : 1.0f;
+    const int index_offset = AllocIndexEntry(dst);
+    IndexLookup[index_offset] = src_lookup;
+    IndexAdvanceX[index_offset] = src_advance_x;
+    if (ContainerAtlas != NULL)
+        ContainerAtlas->BuildCounter++;
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
-    if (i == (ImWchar)-1)
-        return FallbackGlyph;
-    return &Glyphs.Data[i];
+    const int index_offset = GetIndexOffset(c);
+    const ImWchar i = (index_offset >= 0) ? IndexLookup.Data[index_offset] : (ImWchar)-1;
+    if (i != (ImWchar)-1)
+        return &Glyphs.Data[i];
+    if (ContainerAtlas != NULL && ContainerAtlas->IncrementalData != NULL) // ImFontAtlasFlags_IncrementalGlyphs: rasterize during next NewFrame()
+        ImFontAtlasBuildQueueGlyph(ContainerAtlas, this, c);
+    return FallbackGlyph;
 }
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
+    const int index_offset = GetIndexOffset(c);
+    if (index_offset < 0)
         return NULL;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = IndexLookup.Data[index_offset];
     if (i == (ImWchar)-1)
         return NULL;
     return &Glyphs.Data[i];
 }
 
+// Return end of the run of printable ASCII characters (0x20..0x7F) starting at 'text'.
+// Those characters don't need UTF-8 decoding and their advance can be read directly from the first page of the glyph index.
+static inline const char* CalcPrintableAsciiRunEndA(const char* text, const char* text_end)
+{
+#ifdef IMGUI_ENABLE_SSE2
+    // Bytes >= 0x80 are negative as signed chars: a single signed compare rejects them along with control characters.
+    const __m128i min_printable = _mm_set1_epi8(0x1F);
+    while (text_end - text >= 16 && _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)(const void*)text), min_printable)) == 0xFFFF)
+        text += 16;
+#endif
+    while (text < text_end && (signed char)*text > 0x1F)
+        text++;
+    return text;
+}
+
 // Wrapping skips upcoming blanks
 static inline const char* CalcWordWrapNextLineStartA(const char* text, const char* text_end)
 {
@@ -3832,34 +5002,50 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     const char* prev_word_end = NULL;
     bool inside_word = true;
 
+    // Advances of ASCII characters are stored contiguously in the first page of the glyph index
+    const float* ascii_advance_x = (IndexPages.Size > 0) ? &IndexAdvanceX.Data[(int)IndexPages.Data[0] << IM_FONT_INDEX_PAGE_SHIFT] : NULL;
+    const char* ascii_run_end = text;
+
     const char* s = text;
     IM_ASSERT(text_end != NULL);
     while (s < text_end)
     {
         unsigned int c = (unsigned int)*s;
         const char* next_s;
-        if (c < 0x80)
+        float char_width;
+        if (s >= ascii_run_end && ascii_advance_x != NULL && c >= 0x20 && c < 0x80)
+            ascii_run_end = CalcPrintableAsciiRunEndA(s, text_end);
+        if (s < ascii_run_end)
+        {
+            // Fast path: printable ASCII
             next_s = s + 1;
+            char_width = ascii_advance_x[c];
+        }
         else
-            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
-
-        if (c < 32)
         {
-            if (c == '\n')
-            {
-                line_width = word_width = blank_width = 0.0f;
-                inside_word = true;
-                s = next_s;
-                continue;
-            }
-            if (c == '\r')
+            if (c < 0x80)
+                next_s = s + 1;
+            else
+                next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+
+            if (c < 32)
             {
-                s = next_s;
-                continue;
+                if (c == '\n')
+                {
+                    line_width = word_width = blank_width = 0.0f;
+                    inside_word = true;
+                    s = next_s;
+                    continue;
+                }
+                if (c == '\r')
+                {
+                    s = next_s;
+                    continue;
+                }
             }
+            char_width = GetCharAdvance((ImWchar)c);
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
         if (ImCharIsBlankW(c))
         {
             if (inside_word)
@@ -3922,6 +5108,9 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
+    // Advances of ASCII characters are stored contiguously in the first page of the glyph index
+    const float* ascii_advance_x = (IndexPages.Size > 0) ? &IndexAdvanceX.Data[(int)IndexPages.Data[0] << IM_FONT_INDEX_PAGE_SHIFT] : NULL;
+
     const char* s = text_begin;
     while (s < text_end)
     {
@@ -3943,6 +5132,23 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Fast path: measure run of printable ASCII characters without decoding
+        if (ascii_advance_x != NULL && (signed char)*s > 0x1F)
+        {
+            const char* run_end = CalcPrintableAsciiRunEndA(s, word_wrap_enabled ? word_wrap_eol : text_end);
+            while (s < run_end)
+            {
+                const float char_width = ascii_advance_x[(unsigned char)*s] * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+                s++;
+            }
+            if (s < run_end)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -3964,7 +5170,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 continue;
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX) * scale;
+        const float char_width = GetCharAdvance((ImWchar)c) * scale;
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -4001,6 +5207,72 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->PrimRectUV(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+// Write indices of 'quad_count' consecutive quads made of 4 vertices each, starting at vertex 'vtx_index'.
+// RenderText() writes all indices in one pass once the number of emitted glyph quads is known.
+static inline ImDrawIdx* WriteQuadsIndices(ImDrawIdx* idx_write, unsigned int vtx_index, int quad_count)
+{
+#ifdef IMGUI_ENABLE_SSE2
+    // Write 4 quads at a time: 24 indices = 3 (16-bit indices) or 6 (32-bit indices) vectors
+    static const ImDrawIdx quads_indices[4 * 6] = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7, 8, 9, 10, 8, 10, 11, 12, 13, 14, 12, 14, 15 };
+    const int vec_count = (int)sizeof(quads_indices) / (int)sizeof(__m128i);
+    const bool idx_16bit = (sizeof(ImDrawIdx) == 2);
+    __m128i vtx_base = idx_16bit ? _mm_set1_epi16((short)vtx_index) : _mm_set1_epi32((int)vtx_index);
+    const __m128i vtx_step = idx_16bit ? _mm_set1_epi16(16) : _mm_set1_epi32(16);
+    for (; quad_count >= 4; quad_count -= 4, vtx_index += 16, idx_write += 4 * 6)
+    {
+        for (int n = 0; n < vec_count; n++)
+        {
+            const __m128i indices = _mm_loadu_si128((const __m128i*)(const void*)quads_indices + n);
+            _mm_storeu_si128((__m128i*)(void*)idx_write + n, idx_16bit ? _mm_add_epi16(vtx_base, indices) : _mm_add_epi32(vtx_base, indices));
+        }
+        vtx_base = idx_16bit ? _mm_add_epi16(vtx_base, vtx_step) : _mm_add_epi32(vtx_base, vtx_step);
+    }
+#endif
+    for (; quad_count > 0; quad_count--, vtx_index += 4, idx_write += 6)
+    {
+        idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+        idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+    }
+    return idx_write;
+}
+
+#if defined(IMGUI_ENABLE_SSE2) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+// Write the 4 vertices of a glyph quad with 5 unaligned stores. 'pos' = (x1, y1, x2, y2), 'uv' = (u1, v1, u2, v2).
+// Requires the default ImDrawVert layout (pos, uv, col = 20 bytes).
+static inline void WriteGlyphQuadVerticesSSE2(ImDrawVert* vtx_write, __m128 pos, __m128 uv, ImU32 col)
+{
+    IM_STATIC_ASSERT(sizeof(ImDrawVert) == 20 && offsetof(ImDrawVert, pos) == 0 && offsetof(ImDrawVert, uv) == 8 && offsetof(ImDrawVert, col) == 16);
+    const __m128 c = _mm_castsi128_ps(_mm_set1_epi32((int)col));
+    float* dst = &vtx_write[0].pos.x;
+    _mm_storeu_ps(dst + 0,  _mm_movelh_ps(pos, uv));                                                                                            // x1 y1 u1 v1
+    _mm_storeu_ps(dst + 4,  _mm_shuffle_ps(_mm_shuffle_ps(c, pos, _MM_SHUFFLE(2, 2, 0, 0)), _mm_shuffle_ps(pos, uv, _MM_SHUFFLE(2, 2, 1, 1)), _MM_SHUFFLE(2, 0, 2, 0)));   // c  x2 y1 u2
+    _mm_storeu_ps(dst + 8,  _mm_shuffle_ps(_mm_shuffle_ps(uv, c, _MM_SHUFFLE(0, 0, 1, 1)), pos, _MM_SHUFFLE(3, 2, 2, 0)));                       // v1 c  x2 y2
+    _mm_storeu_ps(dst + 12, _mm_shuffle_ps(uv, _mm_shuffle_ps(c, pos, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(2, 0, 3, 2)));                       // u2 v2 c  x1
+    _mm_storeu_ps(dst + 16, _mm_shuffle_ps(_mm_shuffle_ps(pos, uv, _MM_SHUFFLE(0, 0, 3, 3)), _mm_shuffle_ps(uv, c, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));   // y2 u1 v2 c
+}
+
+// CPU side clipping of a glyph quad to 'clip_min' = (x, y, x, y) and 'clip_max' = (z, w, z, w), adjusting texture coordinates of clipped corners.
+// Return false when the quad is fully clipped vertically.
+static inline bool ClipGlyphQuadSSE2(__m128* pos, __m128* uv, __m128 clip_min, __m128 clip_max)
+{
+    const __m128 p = *pos;
+    const __m128 p_clipped = _mm_min_ps(_mm_max_ps(p, clip_min), clip_max);
+    const __m128 clipped_mask = _mm_cmpneq_ps(p_clipped, p);
+    if (_mm_movemask_ps(clipped_mask) == 0)
+        return true;
+    if (_mm_movemask_ps(_mm_cmpge_ps(p_clipped, _mm_movehl_ps(p_clipped, p_clipped))) & 0x02) // y1 >= y2
+        return false;
+    const __m128 p1 = _mm_movelh_ps(p, p);
+    const __m128 p2 = _mm_movehl_ps(p, p);
+    const __m128 uv1 = _mm_movelh_ps(*uv, *uv);
+    const __m128 uv2 = _mm_movehl_ps(*uv, *uv);
+    const __m128 uv_clipped = _mm_add_ps(uv1, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(p_clipped, p1), _mm_sub_ps(p2, p1)), _mm_sub_ps(uv2, uv1)));
+    *uv = _mm_or_ps(_mm_and_ps(clipped_mask, uv_clipped), _mm_andnot_ps(clipped_mask, *uv));
+    *pos = p_clipped;
+    return true;
+}
+#endif
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
@@ -4062,10 +5334,16 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
     draw_list->PrimReserve(idx_count_max, vtx_count_max);
     ImDrawVert*  vtx_write = draw_list->_VtxWritePtr;
+    ImDrawVert*  vtx_write_start = vtx_write;
     ImDrawIdx*   idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_index = draw_list->_VtxCurrentIdx;
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+#if defined(IMGUI_ENABLE_SSE2) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+    const __m128 scale4 = _mm_set1_ps(scale);
+    const __m128 clip_min = _mm_setr_ps(clip_rect.x, clip_rect.y, clip_rect.x, clip_rect.y);
+    const __m128 clip_max = _mm_setr_ps(clip_rect.z, clip_rect.w, clip_rect.z, clip_rect.w);
+#endif
     const char* word_wrap_eol = NULL;
 
     while (s < text_end)
@@ -4119,11 +5397,25 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
             // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
             float x1 = x + glyph->X0 * scale;
             float x2 = x + glyph->X1 * scale;
-            float y1 = y + glyph->Y0 * scale;
-            float y2 = y + glyph->Y1 * scale;
             if (x1 <= clip_rect.z && x2 >= clip_rect.x)
             {
+                // Support for untinted glyphs
+                ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+
+#if defined(IMGUI_ENABLE_SSE2) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+                // Render a character: compute the 4 corners at once (same operations as the scalar path below), write vertices with 5 stores.
+                __m128 pos4 = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&glyph->X0), scale4), _mm_setr_ps(x, y, x, y));
+                __m128 uv4 = _mm_loadu_ps(&glyph->U0);
+                if (cpu_fine_clip && !ClipGlyphQuadSSE2(&pos4, &uv4, clip_min, clip_max))
+                {
+                    x += char_width;
+                    continue;
+                }
+                WriteGlyphQuadVerticesSSE2(vtx_write, pos4, uv4, glyph_col);
+#else
                 // Render a character
+                float y1 = y + glyph->Y0 * scale;
+                float y2 = y + glyph->Y1 * scale;
                 float u1 = glyph->U0;
                 float v1 = glyph->V0;
                 float u2 = glyph->U1;
@@ -4159,26 +5451,23 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
                     }
                 }
 
-                // Support for untinted glyphs
-                ImU32 glyph_col = glyph->Colored ? col_untinted : col;
-
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
-                {
-                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
-                    idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
-                    idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
-                    vtx_write += 4;
-                    vtx_index += 4;
-                    idx_write += 6;
-                }
+                vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+#endif
+                vtx_write += 4; // Indices are written after the loop
             }
         }
         x += char_width;
     }
 
+    // Write indices of all emitted quads in one pass
+    const int quad_count = (int)(vtx_write - vtx_write_start) / 4;
+    idx_write = WriteQuadsIndices(idx_write, vtx_index, quad_count);
+    vtx_index += (unsigned int)quad_count * 4;
+
     // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
     draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
     draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
@@ -4188,6 +5477,234 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->_VtxCurrentIdx = vtx_index;
 }
 
+// Coverage of a texel sampled from a distance field atlas (ImFontAtlasFlags_SDF), given the screen-space derivative of the sampled value.
+// Renderer backends setting ImGuiBackendFlags_RendererHasSdfFonts implement the same function in their shader:
+//   float d = texture(Texture, uv).a;
+//   float w = max(fwidth(d) * 0.5, 0.001);
+//   float coverage = smoothstep(0.5 - w, 0.5 + w, d);
+float ImFontAtlasSdfCoverage(float sdf_value, float sdf_fwidth)
+{
+    const float w = ImMax(sdf_fwidth * 0.5f, 0.001f);
+    const float t = ImSaturate((sdf_value - (0.5f - w)) / (2.0f * w));
+    return t * t * (3.0f - 2.0f * t);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImImageAtlas
+//-----------------------------------------------------------------------------
+
+struct ImImageAtlasPackContext
+{
+    stbrp_context           Context;
+    ImVector<stbrp_node>    Nodes;
+};
+
+ImImageAtlas::ImImageAtlas()
+{
+    PageWidth = PageHeight = 1024;
+    PagesMax = 4;
+    Padding = 1;
+    UpdateTextureFn = NULL;
+    UserData = NULL;
+}
+
+ImImageAtlas::~ImImageAtlas()
+{
+    Clear();
+}
+
+void ImImageAtlas::Clear()
+{
+    for (ImImageAtlasPage& page : Pages)
+    {
+        IM_FREE(page.Pixels);
+        IM_DELETE((ImImageAtlasPackContext*)page.PackContext);
+    }
+    Pages.clear();
+    Entries.clear();
+    EntriesMap.Clear();
+}
+
+static void ImImageAtlasPageResetPacker(ImImageAtlasPage* page)
+{
+    ImImageAtlasPackContext* pack = (ImImageAtlasPackContext*)page->PackContext;
+    pack->Nodes.resize(page->Width);
+    stbrp_init_target(&pack->Context, page->Width, page->Height, pack->Nodes.Data, pack->Nodes.Size);
+}
+
+static bool ImImageAtlasPageTryPack(ImImageAtlasPage* page, int w, int h, int* out_x, int* out_y)
+{
+    stbrp_rect r;
+    memset(&r, 0, sizeof(r));
+    r.w = (stbrp_coord)w;
+    r.h = (stbrp_coord)h;
+    stbrp_pack_rects(&((ImImageAtlasPackContext*)page->PackContext)->Context, &r, 1);
+    if (!r.was_packed)
+        return false;
+    *out_x = r.x;
+    *out_y = r.y;
+    return true;
+}
+
+static void ImImageAtlasPageAddDirtyRect(ImImageAtlasPage* page, int x, int y, int w, int h)
+{
+    ImTextureRect* r = &page->DirtyRect;
+    if (r->w == 0)
+    {
+        r->x = (unsigned short)x; r->y = (unsigned short)y;
+        r->w = (unsigned short)w; r->h = (unsigned short)h;
+        return;
+    }
+    const int x1 = ImMax(r->x + r->w, x + w);
+    const int y1 = ImMax(r->y + r->h, y + h);
+    r->x = (unsigned short)ImMin((int)r->x, x);
+    r->y = (unsigned short)ImMin((int)r->y, y);
+    r->w = (unsigned short)(x1 - r->x);
+    r->h = (unsigned short)(y1 - r->y);
+}
+
+// Drop all images of a page and reset its packer. Texture and pixels are kept for reuse.
+void ImImageAtlas::EvictPage(int page_index)
+{
+    ImImageAtlasPage* page = &Pages[page_index];
+    for (int n = 0; n < Entries.Size; n++)
+    {
+        if (Entries[n].PageIndex != page_index)
+            continue;
+        EntriesMap.SetInt(Entries[n].Key, 0);
+        if (n != Entries.Size - 1)
+        {
+            Entries[n] = Entries.back();
+            EntriesMap.SetInt(Entries[n].Key, n + 1);
+        }
+        Entries.pop_back();
+        n--;
+    }
+    page->ImagesCount = 0;
+    ImImageAtlasPageResetPacker(page);
+}
+
+bool ImImageAtlas::AddImage(ImGuiID key, int width, int height, const unsigned char* rgba_pixels, int pitch)
+{
+    IM_ASSERT(width > 0 && height > 0 && rgba_pixels != NULL);
+    IM_ASSERT(PageWidth > 0 && PageWidth <= 0xFFFF && PageHeight > 0 && PageHeight <= 0xFFFF && PagesMax > 0);
+    const int pack_w = width + Padding;
+    const int pack_h = height + Padding;
+    if (pack_w > PageWidth || pack_h > PageHeight)
+        return false;
+    RemoveImage(key);
+
+    // Try existing pages, then a new page, then evict least recently used page which hasn't been used this frame.
+    int x = 0, y = 0;
+    int page_index = -1;
+    for (int n = 0; n < Pages.Size && page_index == -1; n++)
+        if (Pages[n].Width >= pack_w && Pages[n].Height >= pack_h && ImImageAtlasPageTryPack(&Pages[n], pack_w, pack_h, &x, &y))
+            page_index = n;
+    if (page_index == -1 && Pages.Size < PagesMax)
+    {
+        Pages.push_back(ImImageAtlasPage());
+        ImImageAtlasPage* page = &Pages.back();
+        page->Width = PageWidth;
+        page->Height = PageHeight;
+        page->Pixels = (unsigned int*)IM_ALLOC((size_t)page->Width * page->Height * 4);
+        memset(page->Pixels, 0, (size_t)page->Width * page->Height * 4);
+        page->PackContext = IM_NEW(ImImageAtlasPackContext)();
+        ImImageAtlasPageResetPacker(page);
+
+        // Create texture immediately so GetImage() can return a valid TexID during this frame.
+        ImTextureRect full_rect = { 0, 0, (unsigned short)page->Width, (unsigned short)page->Height };
+        if (UpdateTextureFn != NULL)
+            UpdateTextureFn(this, page, full_rect);
+        else
+            page->DirtyRect = full_rect;
+        if (ImImageAtlasPageTryPack(page, pack_w, pack_h, &x, &y))
+            page_index = Pages.Size - 1;
+    }
+    if (page_index == -1)
+    {
+        const int current_frame = GImGui ? GImGui->FrameCount : 0;
+        int evict_index = -1;
+        for (int n = 0; n < Pages.Size; n++)
+            if (Pages[n].LastUsedFrame != current_frame && Pages[n].Width >= pack_w && Pages[n].Height >= pack_h)
+                if (evict_index == -1 || Pages[n].LastUsedFrame < Pages[evict_index].LastUsedFrame)
+                    evict_index = n;
+        if (evict_index == -1)
+            return false;
+        EvictPage(evict_index);
+        if (!ImImageAtlasPageTryPack(&Pages[evict_index], pack_w, pack_h, &x, &y))
+            return false;
+        page_index = evict_index;
+    }
+
+    // Copy pixels, and clear the padding on the right and bottom sides: pages are reused after eviction,
+    // so it may contain pixels from evicted images which would bleed into edges with bilinear filtering.
+    ImImageAtlasPage* page = &Pages[page_index];
+    if (pitch == 0)
+        pitch = width * 4;
+    for (int row = 0; row < height; row++)
+    {
+        unsigned int* dst = page->Pixels + (size_t)(y + row) * page->Width + x;
+        memcpy(dst, rgba_pixels + (size_t)row * pitch, (size_t)width * 4);
+        memset(dst + width, 0, (size_t)(pack_w - width) * 4);
+    }
+    for (int row = height; row < pack_h; row++)
+        memset(page->Pixels + (size_t)(y + row) * page->Width + x, 0, (size_t)pack_w * 4);
+    ImImageAtlasPageAddDirtyRect(page, x, y, pack_w, pack_h);
+    page->ImagesCount++;
+
+    ImImageAtlasEntry entry;
+    entry.Key = key;
+    entry.PageIndex = page_index;
+    entry.X = (unsigned short)x;
+    entry.Y = (unsigned short)y;
+    entry.Width = (unsigned short)width;
+    entry.Height = (unsigned short)height;
+    Entries.push_back(entry);
+    EntriesMap.SetInt(key, Entries.Size);
+    return true;
+}
+
+bool ImImageAtlas::GetImage(ImGuiID key, ImTextureID* out_tex_id, ImVec2* out_uv0, ImVec2* out_uv1)
+{
+    const int entry_idx = EntriesMap.GetInt(key, 0) - 1;
+    if (entry_idx < 0)
+        return false;
+    const ImImageAtlasEntry* entry = &Entries[entry_idx];
+    ImImageAtlasPage* page = &Pages[entry->PageIndex];
+    page->LastUsedFrame = GImGui ? GImGui->FrameCount : 0;
+    const ImVec2 uv_scale(1.0f / page->Width, 1.0f / page->Height);
+    *out_tex_id = page->TexID;
+    *out_uv0 = ImVec2(entry->X * uv_scale.x, entry->Y * uv_scale.y);
+    *out_uv1 = ImVec2((entry->X + entry->Width) * uv_scale.x, (entry->Y + entry->Height) * uv_scale.y);
+    return true;
+}
+
+void ImImageAtlas::RemoveImage(ImGuiID key)
+{
+    const int entry_idx = EntriesMap.GetInt(key, 0) - 1;
+    if (entry_idx < 0)
+        return;
+    Pages[Entries[entry_idx].PageIndex].ImagesCount--;
+    EntriesMap.SetInt(key, 0);
+    if (entry_idx != Entries.Size - 1)
+    {
+        Entries[entry_idx] = Entries.back();
+        EntriesMap.SetInt(Entries[entry_idx].Key, entry_idx + 1);
+    }
+    Entries.pop_back();
+}
+
+void ImImageAtlas::UpdateTextures()
+{
+    for (ImImageAtlasPage& page : Pages)
+    {
+        if (page.DirtyRect.w == 0 || page.DirtyRect.h == 0 || UpdateTextureFn == NULL)
+            continue;
+        UpdateTextureFn(this, &page, page.DirtyRect);
+        memset(&page.DirtyRect, 0, sizeof(page.DirtyRect));
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGui Internal Render Helpers
 //-----------------------------------------------------------------------------
@@ -4418,6 +5935,9 @@ static void stb__match(const unsigned char *data, unsigned int length)
     IM_ASSERT(stb__dout + length <= stb__barrier_out_e);
     if (stb__dout + length > stb__barrier_out_e) { stb__dout += length; return; }
     if (data < stb__barrier_out_b) { stb__dout = stb__barrier_out_e+1; return; }
+    const unsigned int dist = (unsigned int)(stb__dout - data);
+    if (dist >= length)     { memcpy(stb__dout, data, length); stb__dout += length; return; } // No overlap
+    if (dist == 1)          { memset(stb__dout, *data, length); stb__dout += length; return; } // Run of a single byte (frequent in TTF tables)
     while (length--) *stb__dout++ = *data++;
 }
 
@@ -4459,7 +5979,36 @@ static unsigned int stb_adler32(unsigned int adler32, unsigned char *buffer, uns
 
     unsigned long i;
     while (buflen) {
-        for (i=0; i + 7 < blocklen; i += 8) {
+        i = 0;
+#ifdef IMGUI_ENABLE_SSE2
+        // 16 bytes per iteration: s1 gains their sum, s2 gains 16*s1 plus the bytes weighted 16..1.
+        // Partial sums stay in 32-bit lanes as blocklen <= 5552, the final combination is done in 64-bit.
+        if (blocklen >= 16) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i weights_lo = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+            const __m128i weights_hi = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+            __m128i v_s1 = zero, v_s1_prev_sum = zero, v_s2 = zero;
+            for (; i + 15 < blocklen; i += 16) {
+                const __m128i bytes = _mm_loadu_si128((const __m128i*)(const void*)(buffer + i));
+                v_s1_prev_sum = _mm_add_epi32(v_s1_prev_sum, v_s1);
+                v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes, zero));
+                v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_unpacklo_epi8(bytes, zero), weights_lo));
+                v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_unpackhi_epi8(bytes, zero), weights_hi));
+            }
+            unsigned int l_s1[4], l_s1_prev_sum[4], l_s2[4];
+            _mm_storeu_si128((__m128i*)(void*)l_s1, v_s1);
+            _mm_storeu_si128((__m128i*)(void*)l_s1_prev_sum, v_s1_prev_sum);
+            _mm_storeu_si128((__m128i*)(void*)l_s2, v_s2);
+            const ImU64 s2_block = (ImU64)i * s1 + 16 * ((ImU64)l_s1_prev_sum[0] + l_s1_prev_sum[2]) + ((ImU64)l_s2[0] + l_s2[1] + l_s2[2] + l_s2[3]);
+            s2 = (unsigned long)((s2 + s2_block) % ADLER_MOD);
+            s1 += l_s1[0] + l_s1[2];
+            buffer += i;
+            blocklen -= i;
+            buflen -= i;
+            i = 0;
+        }
+#endif
+        for (; i + 7 < blocklen; i += 8) {
             s1 += buffer[0], s2 += s1;
             s1 += buffer[1], s2 += s1;
             s1 += buffer[2], s2 += s1;
@@ -60,6 +60,9 @@ Index of this file:
 #define IMGUI_ENABLE_SSE
 #include <immintrin.h>
 #endif
+#if defined(IMGUI_ENABLE_SSE) && (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_ENABLE_SSE2
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -205,8 +208,6 @@ namespace ImStb
 #define IMSTB_TEXTEDIT_STRING             ImGuiInputTextState
 #define IMSTB_TEXTEDIT_CHARTYPE           ImWchar
 #define IMSTB_TEXTEDIT_GETWIDTH_NEWLINE   (-1.0f)
-#define IMSTB_TEXTEDIT_UNDOSTATECOUNT     99
-#define IMSTB_TEXTEDIT_UNDOCHARCOUNT      999
 #include "imstb_textedit.h"
 
 } // namespace ImStb
@@ -352,6 +353,7 @@ namespace ImStb
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+IMGUI_API ImU64         ImHashData64(const void* data, size_t data_size, ImU64 seed = 0);
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -734,6 +736,57 @@ struct ImGuiTextIndex
     void            append(const char* base, int old_size, int new_size);
 };
 
+// Helper: ImGuiTextBlockIndex
+// Line index and layout data of a large text block, allowing TextEx() to render it in O(visible lines).
+// Extended incrementally when text is appended: we assume text before Lines.EndOffset doesn't change while TextBegin stays the same.
+// (TextEx() verifies that visible lines still start after a '\n' and rebuilds the index otherwise)
+struct ImGuiTextBlockIndex
+{
+    ImGuiTextIndex  Lines;                                  // Offsets of source lines
+    const char*     TextBegin = NULL;                       // Buffer the index was built for
+    int             LastFrameActive = -1;                   // Last frame used. Context-owned indices are discarded when not used for a frame.
+
+    // Layout data, reset when font, font size, wrap width or width measurement change
+    ImFont*         LayoutFont = NULL;
+    float           LayoutFontSize = 0.0f;
+    float           LayoutWrapWidth = 0.0f;                 // 0.0f when not wrapping
+    bool            LayoutMeasureWidth = false;             // Measure all lines width (otherwise only visible lines are measured, ImGuiTextFlags_NoWidthForLargeClippedText)
+    int             LayoutLinesCount = 0;                   // Number of source lines measured so far
+    float           LayoutMaxWidth = 0.0f;                  // Max width of measured lines
+    ImVector<int>   WrapLinesPrefix;                        // When wrapping: WrapLinesPrefix[n] = number of visual lines before source line n. Size = LayoutLinesCount + 1.
+
+    void            clear()                                 { Lines.clear(); TextBegin = NULL; clear_layout(); }
+    void            clear_layout()                          { LayoutLinesCount = 0; LayoutMaxWidth = 0.0f; WrapLinesPrefix.resize(0); }
+};
+
+// Helper: ImGuiTextSizeCache
+// LRU cache of CalcTextSize() results, enabled with io.ConfigTextSizeCacheSize > 0.
+// Entries are identified by a 64-bit hash of text + font + font size + wrap width: text is neither stored nor compared.
+struct ImGuiTextSizeCacheEntry
+{
+    ImU64           Key;
+    ImVec2          Size;
+    int             BucketNext;                             // Next entry in same hash bucket, -1 if none
+    int             LruPrev, LruNext;                       // Doubly-linked list from most recently used (LruHead) to least recently used (LruTail)
+};
+
+struct ImGuiTextSizeCache
+{
+    ImVector<ImGuiTextSizeCacheEntry> Entries;              // Never grows past Capacity, so pointers are stable until Clear()
+    ImVector<int>   Buckets;                                // First entry of each hash bucket, -1 if empty. Size is a power of two.
+    int             Capacity = 0;
+    int             LruHead = -1, LruTail = -1;
+    ImFontAtlas*    FontAtlas = NULL;                       // Atlas of the fonts measured, and its BuildCounter at the time. Entries are cleared when it changes.
+    int             FontAtlasBuildCounter = 0;
+    int             HitsCount = 0, MissesCount = 0;         // Stats for current frame
+    int             HitsCountLastFrame = 0, MissesCountLastFrame = 0;
+
+    void            Clear();                                // Remove all entries, keep capacity
+    void            SetCapacity(int capacity);              // Reallocate for 'capacity' entries. 0 to free all memory.
+    const ImVec2*   Find(ImU64 key);                        // Return cached size and mark entry as most recently used. NULL if not found.
+    void            Add(ImU64 key, const ImVec2& size);     // Add entry, evicting least recently used one when full. Key must not be already present.
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawList support
 //-----------------------------------------------------------------------------
@@ -989,6 +1042,13 @@ enum ImGuiPlotType
     ImGuiPlotType_Histogram,
 };
 
+// Summary of the values covered by one pixel column, when PlotEx() has more values than pixels
+struct ImGuiPlotColumn
+{
+    float   Min, Max;           // Ignoring NaN values. Min > Max if all values are NaN.
+    float   First, Last;        // Values at both ends of the column, to connect lines to neighbor columns
+};
+
 // Stacked color modifier, backup of modified data so we can restore it
 struct ImGuiColorMod
 {
@@ -1064,6 +1124,27 @@ struct IMGUI_API ImGuiInputTextDeactivatedState
     ImGuiInputTextDeactivatedState()    { memset(this, 0, sizeof(*this)); }
     void    ClearFreeMemory()           { ID = 0; TextA.clear(); }
 };
+// Position of a '\n' in ImGuiInputTextState edit buffer, in both TextW and TextA
+struct ImGuiInputTextNewline
+{
+    int                     IdxW;                   // index in TextW (logical, excluding the gap)
+    int                     OffsetA;                // offset in TextA
+};
+
+// Color span of a line, submitted by ImGuiInputTextFlags_CallbackColor callback with ImGuiInputTextCallbackData::AddColorSpan()
+struct ImGuiInputTextColorSpan
+{
+    int                     Start, End;             // byte offsets in the line
+    ImU32                   Col;
+};
+
+// Cached color spans of a line
+struct ImGuiInputTextColorLine
+{
+    int                     Line;
+    int                     SpansStart, SpansCount; // in ImGuiInputTextState::ColorSpans[]
+};
+
 // Internal state of the currently focused/edited text input box
 // For a given item ID, access with ImGui::GetInputTextState()
 struct IMGUI_API ImGuiInputTextState
@@ -1071,10 +1152,18 @@ struct IMGUI_API ImGuiInputTextState
     ImGuiContext*           Ctx;                    // parent UI context (needs to be set explicitly by parent).
     ImGuiID                 ID;                     // widget id owning the text state
     int                     CurLenW, CurLenA;       // we need to maintain our buffer length in both UTF-8 and wchar format. UTF-8 length is valid even if TextA is not.
-    ImVector<ImWchar>       TextW;                  // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer.
-    ImVector<char>          TextA;                  // temporary UTF8 buffer for callbacks and other operations. this is not updated in every code-path! size=capacity.
+    ImVector<ImWchar>       TextW;                  // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer. Gap buffer: read with GetCharW()!
+    int                     GapPosW;                // gap position in TextW: text is TextW[0..GapPosW) + TextW[GapPosW+GetGapLenW()..TextW.Size-1). Edits move the gap to their location instead of shifting the rest of the buffer.
+    int                     GapPosA;                // offset in TextA matching GapPosW, so edits can be applied to TextA without converting the whole text.
+    ImVector<char>          TextA;                  // UTF-8 copy of TextW, updated along with it by every edit. Used for display, callbacks, and applying back to user buffer. size=capacity.
+    ImVector<ImGuiInputTextNewline> NewlinesBeforeGap; // line index: '\n' positions before the gap, in increasing order.
+    ImVector<ImGuiInputTextNewline> NewlinesAfterGap;  // line index: '\n' positions after the gap, stored as distance from the end of text so edits at the gap don't need to update them. Nearest to the gap is at the back.
+    ImVector<ImGuiInputTextColorLine> ColorLines;   // ImGuiInputTextFlags_CallbackColor cache: visible lines colored by callback, sorted by line
+    ImVector<ImGuiInputTextColorSpan> ColorSpans;   // ImGuiInputTextFlags_CallbackColor cache: spans for ColorLines[] (may contain unused spans until compacted)
+    int                     ColorDirtyLineMin;      // ImGuiInputTextFlags_CallbackColor cache: range of lines edited since last render, invalidated before use
+    int                     ColorDirtyLineMax;
     ImVector<char>          InitialTextA;           // value to revert to when pressing Escape = backup of end-user buffer at the time of focus (in UTF-8, unaltered)
-    bool                    TextAIsValid;           // temporary UTF8 buffer is not initially valid before we make the widget active (until then we pull the data from user argument)
+    bool                    TextAIsValid;           // UTF-8 buffer is not initially valid before we make the widget active (until then we pull the data from user argument)
     int                     BufCapacityA;           // end-user buffer capacity
     float                   ScrollX;                // horizontal scrolling/offset
     ImStb::STB_TexteditState Stb;                   // state for stb_textedit.h
@@ -1088,12 +1177,28 @@ struct IMGUI_API ImGuiInputTextState
     int                     ReloadSelectionEnd;
 
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
+    void        ClearText()                 { CurLenW = CurLenA = 0; GapPosW = GapPosA = 0; TextA[0] = 0; NewlinesBeforeGap.resize(0); NewlinesAfterGap.resize(0); SetColorDirtyLines(0, INT_MAX); CursorClamp(); }
+    void        ClearFreeMemory();          // Also frees undo/redo history
     int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
-    int         GetRedoAvailCount() const   { return IMSTB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
+    int         GetRedoAvailCount() const   { return Stb.undostate.undo_rec_count - Stb.undostate.redo_point; }
+    int         GetUndoMemoryUsage() const  { return Stb.undostate.undo_rec_count * (int)sizeof(ImStb::StbUndoRecord) + Stb.undostate.undo_char_count; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
 
+    // Edit buffer (gap buffer)
+    int         GetGapLenW() const          { return TextW.Size - 1 - CurLenW; }
+    ImWchar     GetCharW(int idx) const     { IM_ASSERT(idx >= 0 && idx <= CurLenW); return TextW.Data[idx < GapPosW ? idx : idx + GetGapLenW()]; } // Return 0 for idx == CurLenW
+    void        SetGapAtEndW();                 // Call after writing a contiguous string into TextW (and matching TextA). Rebuilds line index.
+    void        MoveGapW(int pos);
+    void        ReserveGapW(int len);
+
+    // Line index (lines are separated by '\n', there is no word-wrapping in InputText)
+    int         GetLineCount() const        { return NewlinesBeforeGap.Size + NewlinesAfterGap.Size + 1; }
+    ImGuiInputTextNewline GetNewline(int n) const;  // Position of the n-th '\n' == end of line 'n'
+    int         GetLineStartW(int line) const { return line > 0 ? GetNewline(line - 1).IdxW + 1 : 0; }
+    int         GetLineStartA(int line) const { return line > 0 ? GetNewline(line - 1).OffsetA + 1 : 0; }
+    int         GetLineFromIdxW(int idx) const; // Line containing character 'idx' (a '\n' belongs to the line it ends), O(log lines)
+    void        SetColorDirtyLines(int line_min, int line_max) { ColorDirtyLineMin = ImMin(ColorDirtyLineMin, line_min); ColorDirtyLineMax = ImMax(ColorDirtyLineMax, line_max); }
+
     // Cursor & Selection
     void        CursorAnimReset()           { CursorAnim = -0.30f; }                                   // After a user-input the cursor stays on for a while without blinking
     void        CursorClamp()               { Stb.cursor = ImMin(Stb.cursor, CurLenW); Stb.select_start = ImMin(Stb.select_start, CurLenW); Stb.select_end = ImMin(Stb.select_end, CurLenW); }
@@ -1512,6 +1617,26 @@ struct ImGuiListClipperRange
     static ImGuiListClipperRange    FromPositions(float y1, float y2, int off_min, int off_max) { ImGuiListClipperRange r = { (int)y1, (int)y2, true, (ImS8)off_min, (ImS8)off_max }; return r; }
 };
 
+// Persistent item heights for ImGuiListClipper::BeginVariableHeight(), identified by ID.
+// Fenwick trees over measured heights and over the number of measured items give the position of an item,
+// or the item at a position, in O(log N). Items which haven't been measured are assumed to be HeightEstimate high.
+struct ImGuiListClipperHeights
+{
+    ImGuiID                         ID;
+    float                           LastTimeActive;         // Last used timestamp, for garbage collection
+    float                           HeightEstimate;         // Height of items which haven't been measured (0.0f until the first item is measured)
+    ImVector<float>                 Heights;                // Measured height of each item, 0.0f if not measured
+    ImVector<double>                TreeHeights;            // Fenwick tree over Heights[] (1-based, Size = items count + 1)
+    ImVector<int>                   TreeMeasured;           // Fenwick tree over measured items (1-based, Size = items count + 1)
+
+    ImGuiListClipperHeights()       { ID = 0; LastTimeActive = -1.0f; HeightEstimate = 0.0f; }
+    void                            Resize(int items_count);
+    void                            SetItemHeight(int item_n, float height);    // 0.0f to forget a measurement
+    float                           GetItemHeight(int item_n) const             { return Heights[item_n] > 0.0f ? Heights[item_n] : HeightEstimate; }
+    double                          GetItemPos(int item_n) const;               // Sum of heights of items before 'item_n'
+    int                             FindItemAtPos(double pos) const;            // Item containing position 'pos', clamped to valid items
+};
+
 // Temporary clipper data, buffers shared/reused between instances
 struct ImGuiListClipperData
 {
@@ -1519,10 +1644,57 @@ struct ImGuiListClipperData
     float                           LossynessOffset;
     int                             StepNo;
     int                             ItemsFrozen;
+    bool                            StepZeroDone;           // StartPosY and Ranges are set up. Variable height mode displays items one by one, without advancing StepNo until the end of a range.
     ImVector<ImGuiListClipperRange> Ranges;
+    ImGuiListClipperHeights*        Heights;                // Variable height mode: persistent item heights, items are displayed and measured one by one
+    int                             MeasureItem;            // Variable height mode: item displayed by last step, to measure on next step (-1 if none)
+    float                           MeasureStartPosY;
+    float                           ScrollAdjustY;          // Variable height mode: measured height changes of items above the visible area, compensated in scrolling
 
     ImGuiListClipperData()          { memset(this, 0, sizeof(*this)); }
-    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; Ranges.resize(0); }
+    void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; StepZeroDone = false; Ranges.resize(0); Heights = NULL; MeasureItem = -1; ScrollAdjustY = 0.0f; }
+};
+
+// Row of ImGuiTreeClipper: a node whose ancestors are all open, in depth-first order
+struct ImGuiTreeClipperRow
+{
+    void*                           Node;
+    int                             ParentRow;              // Index of parent row, -1 for children of the root
+    int                             Depth;                  // 0 for children of the root
+    bool                            HasChildren;
+    bool                            IsOpen;                 // When open, children rows follow
+};
+
+// Level of depth-first traversal when building rows of ImGuiTreeClipper
+struct ImGuiTreeClipperBuildLevel
+{
+    void*                           Node;
+    int                             Row;                    // Row of 'Node', -1 for the root
+    int                             ChildN;                 // Next child to visit
+    int                             ChildrenCount;
+};
+
+// Persistent data of ImGuiTreeClipper
+struct ImGuiTreeClipperData
+{
+    ImVector<ImGuiTreeClipperRow>   Rows;
+    ImVector<ImGuiTreeClipperRow>   BuildRows;              // Rows of opened subtrees, before insertion into Rows[]
+    ImVector<ImGuiTreeClipperBuildLevel> BuildStack;
+    ImVector<int>                   PushedRows;             // Rows which are currently pushed with TreePush (PushedRows[n] is the ancestor at depth n of the next row)
+    ImVector<int>                   ToggledRows;            // Rows which were opened or closed this frame, updated in End()
+    ImVector<int>                   TempRows;
+    int                             (*GetChildrenCount)(void* user_data, void* node);
+    void*                           (*GetChild)(void* user_data, void* node, int child_n);
+    void*                           UserData;
+    ImGuiTreeNodeFlags              Flags;
+    ImGuiID                         SeedID;                 // ID stack top at the time of Begin(), nodes IDs are computed from it
+    ImGuiStorage*                   Storage;                // Storage for open/close state at the time of Begin()
+    int                             NavRow;                 // Row of last submitted node which had nav focus, -1 if none
+    bool                            IsDirty;                // Rebuild all rows on next Begin()
+    bool                            IsActive;               // Between Begin() and End()
+
+    ImGuiTreeClipperData()          { GetChildrenCount = NULL; GetChild = NULL; UserData = NULL; Flags = 0; SeedID = 0; Storage = NULL; NavRow = -1; IsDirty = true; IsActive = false; }
+    ImGuiID                         GetNodeID(void* node) const { return ImHashData(&node, sizeof(void*), SeedID); }
 };
 
 //-----------------------------------------------------------------------------
@@ -1953,6 +2125,7 @@ struct ImGuiContext
     ImVector<ImGuiWindowStackData> CurrentWindowStack;
     ImGuiStorage            WindowsById;                        // Map window's ImGuiID to ImGuiWindow*
     int                     WindowsActiveCount;                 // Number of unique windows submitted by frame
+    int                     WindowsOccludedCount;               // Number of windows skipped by frame because fully covered by an opaque window (io.ConfigWindowsOcclusionCulling)
     ImVec2                  WindowsHoverPadding;                // Padding around resizable windows for which hovering on counts as hovering the window == ImMax(style.TouchExtraPadding, WINDOWS_HOVER_PADDING)
     ImGuiID                 DebugBreakInWindow;                 // Set to break in Begin() call.
     ImGuiWindow*            CurrentWindow;                      // Window being drawn into
@@ -2124,6 +2297,7 @@ struct ImGuiContext
     // Clipper
     int                             ClipperTempDataStacked;
     ImVector<ImGuiListClipperData>  ClipperTempData;
+    ImVector<ImGuiListClipperHeights*> ClipperHeights;          // Persistent item heights for ImGuiListClipper::BeginVariableHeight()
 
     // Tables
     ImGuiTable*                     CurrentTable;
@@ -2156,7 +2330,12 @@ struct ImGuiContext
     // Widget state
     ImGuiInputTextState     InputTextState;
     ImGuiInputTextDeactivatedState InputTextDeactivatedState;
+    ImVector<ImGuiInputTextColorSpan> InputTextColorSpans;      // Output of ImGuiInputTextFlags_CallbackColor callback
+    ImVector<ImGuiPlotColumn> PlotColumns;                      // Temporary storage for PlotEx() decimation
     ImFont                  InputTextPasswordFont;
+    ImGuiTextSizeCache      TextSizeCache;                      // CalcTextSize() cache (io.ConfigTextSizeCacheSize)
+    ImVector<ImGuiTextBlockIndex*> TextBlockIndices;            // Line indices of large text blocks submitted to TextEx() without their own index, identified by text pointer
+    ImGuiStorage            TextBlockIndicesMap;                // Hash of text pointer -> ImGuiTextBlockIndex* in TextBlockIndices[]
     ImGuiID                 TempInputId;                        // Temporary text input when CTRL+clicking on a slider, etc.
     int                     BeginMenuDepth;
     int                     BeginComboDepth;
@@ -2268,6 +2447,7 @@ struct ImGuiContext
         InputEventsNextEventId = 1;
 
         WindowsActiveCount = 0;
+        WindowsOccludedCount = 0;
         CurrentWindow = NULL;
         HoveredWindow = NULL;
         HoveredWindowUnderMovingWindow = NULL;
@@ -2535,6 +2715,7 @@ struct IMGUI_API ImGuiWindow
     bool                    Appearing;                          // Set during the frame where the window is appearing (or re-appearing)
     bool                    Hidden;                             // Do not display (== HiddenFrames*** > 0)
     bool                    IsFallbackWindow;                   // Set on the "Debug##Default" window.
+    bool                    IsOpaque;                           // Set by RenderWindowDecorations() when background and title bar fully cover window->Rect() with opaque colors. Used by io.ConfigWindowsOcclusionCulling.
     bool                    IsExplicitChild;                    // Set when passed _ChildWindow, left to false by BeginDocked()
     bool                    HasCloseButton;                     // Set when the window has a close button (p_open != NULL)
     signed char             ResizeBorderHovered;                // Current border being hovered for resize (-1: none, otherwise 0-3)
@@ -2703,9 +2884,9 @@ struct IMGUI_API ImGuiTabBar
 //-----------------------------------------------------------------------------
 
 #define IM_COL32_DISABLE                IM_COL32(0,0,0,1)   // Special sentinel code which cannot be used as a regular color.
-#define IMGUI_TABLE_MAX_COLUMNS         512                 // May be further lifted
+#define IMGUI_TABLE_MAX_COLUMNS         4096                // May be further lifted (up to 32767, ImGuiTableColumnIdx is signed 16-bits)
 
-// Our current column maximum is 64 but we may raise that in the future.
+// Our current column maximum is 4096 but we may raise that in the future.
 typedef ImS16 ImGuiTableColumnIdx;
 typedef ImU16 ImGuiTableDrawChannelIdx;
 
@@ -2737,6 +2918,7 @@ struct ImGuiTableColumn
     ImGuiTableColumnIdx     IndexWithinEnabledSet;          // Index within enabled/visible set (<= IndexToDisplayOrder)
     ImGuiTableColumnIdx     PrevEnabledColumn;              // Index of prev enabled/visible column within Columns[], -1 if first enabled/visible column
     ImGuiTableColumnIdx     NextEnabledColumn;              // Index of next enabled/visible column within Columns[], -1 if last enabled/visible column
+    ImGuiTableColumnIdx     NextRequestOutputColumn;        // Index of next column requesting output within Columns[] (in index order, not display order), -1 if none. Used by TableNextVisibleColumn().
     ImGuiTableColumnIdx     SortOrder;                      // Index of this column within sort specs, -1 if not sorting on this column, 0 for single-sort, may be >0 on multi-sort
     ImGuiTableDrawChannelIdx DrawChannelCurrent;            // Index within DrawSplitter.Channels[]
     ImGuiTableDrawChannelIdx DrawChannelFrozen;             // Draw channels for frozen rows (often headers)
@@ -2763,7 +2945,7 @@ struct ImGuiTableColumn
         StretchWeight = WidthRequest = -1.0f;
         NameOffset = -1;
         DisplayOrder = IndexWithinEnabledSet = -1;
-        PrevEnabledColumn = NextEnabledColumn = -1;
+        PrevEnabledColumn = NextEnabledColumn = NextRequestOutputColumn = -1;
         SortOrder = -1;
         SortDirection = ImGuiSortDirection_None;
         DrawChannelCurrent = DrawChannelFrozen = DrawChannelUnfrozen = (ImU8)-1;
@@ -2864,6 +3046,8 @@ struct IMGUI_API ImGuiTable
     ImGuiTableColumnIdx         SortSpecsCount;
     ImGuiTableColumnIdx         ColumnsEnabledCount;        // Number of enabled columns (<= ColumnsCount)
     ImGuiTableColumnIdx         ColumnsEnabledFixedCount;   // Number of enabled columns (<= ColumnsCount)
+    ImGuiTableColumnIdx         ColumnsVisibleCount;        // Number of enabled columns which are not clipped (<= ColumnsEnabledCount). Each gets its own draw channel(s).
+    ImGuiTableColumnIdx         FirstRequestOutputColumn;   // Index of first column requesting output, -1 if none. Columns are linked with NextRequestOutputColumn.
     ImGuiTableColumnIdx         DeclColumnsCount;           // Count calls to TableSetupColumn()
     ImGuiTableColumnIdx         AngledHeadersCount;         // Count columns with angled headers
     ImGuiTableColumnIdx         HoveredColumnBody;          // Index of column whose visible region is being hovered. Important: == ColumnsCount when hovering empty region after the right-most column!
@@ -3025,6 +3209,7 @@ namespace ImGui
     IMGUI_API ImDrawList*   GetBackgroundDrawList(ImGuiViewport* viewport);                     // get background draw list for the given viewport. this draw list will be the first rendering one. Useful to quickly draw shapes/text behind dear imgui contents.
     IMGUI_API ImDrawList*   GetForegroundDrawList(ImGuiViewport* viewport);                     // get foreground draw list for the given viewport. this draw list will be the last rendered one. Useful to quickly draw shapes/text over dear imgui contents.
     IMGUI_API void          AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
+    IMGUI_API void          ParallelFor(int count, void (*job)(void* job_data, int n), void* job_data); // Call job(job_data, n) for n in [0..count), through io.ParallelForFn if set.
 
     // Init
     IMGUI_API void          Initialize();
@@ -3396,7 +3581,7 @@ namespace ImGui
     IMGUI_API void          RenderRectFilledWithHole(ImDrawList* draw_list, const ImRect& outer, const ImRect& inner, ImU32 col, float rounding);
 
     // Widgets
-    IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0);
+    IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0, ImGuiTextBlockIndex* line_index = NULL);
     IMGUI_API bool          ButtonEx(const char* label, const ImVec2& size_arg = ImVec2(0, 0), ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ArrowButtonEx(const char* str_id, ImGuiDir dir, ImVec2 size_arg, ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ImageButtonEx(ImGuiID id, ImTextureID texture_id, const ImVec2& image_size, const ImVec2& uv0, const ImVec2& uv1, const ImVec4& bg_col, const ImVec4& tint_col, ImGuiButtonFlags flags = 0);
@@ -3551,6 +3736,12 @@ IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas,
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API void      ImFontAtlasBuildQueueGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c);
+IMGUI_API void      ImFontAtlasBuildUpdatePendingGlyphs(ImFontAtlas* atlas);
+IMGUI_API bool      ImFontAtlasBuildAddFontIncremental(ImFontAtlas* atlas, int src_i);
+IMGUI_API void      ImFontAtlasBuildPackCustomRectIncremental(ImFontAtlas* atlas, int rect_index);
+IMGUI_API void      ImFontAtlasBuildDestroyIncrementalData(ImFontAtlas* atlas);
+IMGUI_API float     ImFontAtlasSdfCoverage(float sdf_value, float sdf_fwidth);
 
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
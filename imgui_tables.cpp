@@ -178,6 +178,9 @@ Index of this file:
 //
 // - We need to distinguish those cases because non-hidden columns that are clipped outside of scrolling bounds should still contribute their height to the row.
 //   However, in the majority of cases, the contribution to row height is the same for all columns, or the tallest cells are known by the programmer.
+// - TableNextVisibleColumn() only visits columns of case A (and columns performing width measurements), stepping over
+//   the others without touching them. With thousands of columns and ImGuiListClipper for rows, the cost of submitting
+//   contents then scales with the number of cells in sight. TableUpdateLayout() still visits every column once per frame.
 //-----------------------------------------------------------------------------
 // About clipping/culling of whole Tables:
 // - Scrolling tables with a known outer size can be clipped earlier as BeginTable() will return false.
@@ -1014,6 +1017,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     // [Part 6] Setup final position, offset, skip/clip states and clipping rectangles, detect hovered column
     // Process columns in their visible orders as we are comparing the visible order and adjusting host_clip_rect while looping.
     int visible_n = 0;
+    table->ColumnsVisibleCount = 0;
     bool has_at_least_one_column_requesting_output = false;
     bool offset_x_frozen = (table->FreezeColumnsCount > 0);
     float offset_x = ((table->FreezeColumnsCount > 0) ? table->OuterRect.Min.x : work_rect.Min.x) + table->OuterPaddingX - table->CellSpacingX1;
@@ -1090,7 +1094,10 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
         column->IsVisibleY = true; // (column->ClipRect.Max.y > column->ClipRect.Min.y);
         const bool is_visible = column->IsVisibleX; //&& column->IsVisibleY;
         if (is_visible)
+        {
             ImBitArraySetBit(table->VisibleMaskByIndex, column_n);
+            table->ColumnsVisibleCount++;
+        }
 
         // Mark column as requesting output from user. Note that fixed + non-resizable sets are auto-fitting at all times and therefore always request output.
         column->IsRequestOutput = is_visible || column->AutoFitQueue != 0 || column->CannotSkipItemsQueue != 0;
@@ -1161,6 +1168,16 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
         table->Columns[table->LeftMostEnabledColumn].IsSkipItems = false;
     }
 
+    // Link columns requesting output in index order, so TableNextVisibleColumn() can step over clipped columns without visiting them.
+    table->FirstRequestOutputColumn = -1;
+    for (int column_n = table->ColumnsCount - 1; column_n >= 0; column_n--)
+    {
+        ImGuiTableColumn* column = &table->Columns[column_n];
+        column->NextRequestOutputColumn = table->FirstRequestOutputColumn;
+        if (column->IsRequestOutput)
+            table->FirstRequestOutputColumn = (ImGuiTableColumnIdx)column_n;
+    }
+
     // [Part 7] Detect/store when we are hovering the unused space after the right-most column (so e.g. context menus can react on it)
     // Clear Resizable flag if none of our column are actually resizable (either via an explicit _NoResize flag, either
     // because of using _WidthAuto/_WidthStretch). This will hide the resizing option from the context menu.
@@ -2021,6 +2038,7 @@ void ImGui::TableEndRow(ImGuiTable* table)
 // - TableGetColumnIndex()
 // - TableSetColumnIndex()
 // - TableNextColumn()
+// - TableNextVisibleColumn()
 // - TableBeginCell() [Internal]
 // - TableEndCell() [Internal]
 //-------------------------------------------------------------------------
@@ -2080,6 +2098,28 @@ bool ImGui::TableNextColumn()
     return table->Columns[table->CurrentColumn].IsRequestOutput;
 }
 
+// [Public] Append into the next column of current row which is requesting output (visible or performing width measurement).
+// Clipped and hidden columns are skipped without being visited, so cost scales with the number of visible columns.
+// Return false when there is no such column left in the row: call TableNextRow() to start the next row.
+// Same caveat as skipping when TableNextColumn() returns false: skipped columns don't contribute to row height.
+bool ImGui::TableNextVisibleColumn()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    if (!table)
+        return false;
+
+    if (!table->IsInsideRow)
+        TableNextRow();
+    const int column_n = (table->CurrentColumn == -1) ? table->FirstRequestOutputColumn : table->Columns[table->CurrentColumn].NextRequestOutputColumn;
+    if (column_n == -1)
+        return false;
+    if (table->CurrentColumn != -1)
+        TableEndCell(table);
+    TableBeginCell(table, column_n);
+    return true;
+}
+
 
 // [Internal] Called by TableSetColumnIndex()/TableNextColumn()
 // This is called very frequently, so we need to be mindful of unnecessary overhead.
@@ -2412,11 +2452,12 @@ void ImGui::TablePopBackgroundChannel()
 // - Clip                         --> 2+D+N channels
 // - FreezeRows                   --> 2+D+N*2 (unless scrolling value is zero)
 // - FreezeRows || FreezeColunns  --> 3+D+N*2 (unless scrolling value is zero)
-// Where D is 1 if any column is clipped or hidden (dummy channel) otherwise 0.
+// Where D is 1 if any column is clipped or hidden (dummy channel) otherwise 0,
+// and N is the number of visible columns (clipped columns all share the dummy channel).
 void ImGui::TableSetupDrawChannels(ImGuiTable* table)
 {
     const int freeze_row_multiplier = (table->FreezeRowsCount > 0) ? 2 : 1;
-    const int channels_for_row = (table->Flags & ImGuiTableFlags_NoClip) ? 1 : table->ColumnsEnabledCount;
+    const int channels_for_row = (table->Flags & ImGuiTableFlags_NoClip) ? 1 : table->ColumnsVisibleCount;
     const int channels_for_bg = 1 + 1 * freeze_row_multiplier;
     const int channels_for_dummy = (table->ColumnsEnabledCount < table->ColumnsCount || (memcmp(table->VisibleMaskByIndex, table->EnabledMaskByIndex, ImBitArrayGetStorageSizeInBytes(table->ColumnsCount)) != 0)) ? +1 : 0;
     const int channels_total = channels_for_bg + (channels_for_row * freeze_row_multiplier) + channels_for_dummy;
@@ -3006,11 +3047,11 @@ void ImGui::TableHeadersRow()
     if (table->HostSkipItems) // Merely an optimization, you may skip in your own code.
         return;
 
+    // Only visit visible columns (same as calling TableSetColumnIndex() for each column and skipping those returning false)
     const int columns_count = TableGetColumnCount();
-    for (int column_n = 0; column_n < columns_count; column_n++)
+    while (TableNextVisibleColumn())
     {
-        if (!TableSetColumnIndex(column_n))
-            continue;
+        const int column_n = TableGetColumnIndex();
 
         // Push an id to allow unnamed labels (generally accidental, but let's behave nicely with them)
         // In your own code you may omit the PushID/PopID all-together, provided you know they won't collide.
@@ -90,6 +90,7 @@ Index of this file:
 // Widgets
 static const float          DRAGDROP_HOLD_TO_OPEN_TIMER = 0.70f;    // Time for drag-hold to activate items accepting the ImGuiButtonFlags_PressedOnDragDropHold button behavior.
 static const float          DRAG_MOUSE_THRESHOLD_FACTOR = 0.50f;    // Multiplier for the default value of io.MouseDragThreshold to make DragFloat/DragInt react faster to mouse drags.
+static const int            TEXT_LINE_INDEX_MIN_SIZE = 64 * 1024;   // Text size from which TextEx() uses a line index stored in context, so rendering cost depends on visible lines only.
 
 // Those MIN/MAX values are not define because we need to point to them
 static const signed char    IM_S8_MIN  = -128;
@@ -125,7 +126,11 @@ static const ImU64          IM_U64_MAX = (2ULL * 9223372036854775807LL + 1);
 // For InputTextEx()
 static bool     InputTextFilterCharacter(ImGuiContext* ctx, unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data, bool input_source_is_clipboard = false);
 static int      InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end);
-static ImVec2   InputTextCalcTextSizeW(ImGuiContext* ctx, const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining = NULL, ImVec2* out_offset = NULL, bool stop_on_new_line = false);
+static float    InputTextCalcLineWidthW(ImGuiInputTextState* state, int idx_begin, int idx_end, int* out_idx_remaining = NULL);
+static int      InputTextCountUtf8BytesW(const ImGuiInputTextState* state, int idx_begin, int idx_end);
+static int      InputTextStrToUtf8W(const ImGuiInputTextState* state, char* out_buf, int out_buf_size, int idx_begin, int idx_end);
+static int      InputTextGetUtf8OffsetW(const ImGuiInputTextState* state, int idx);
+static void     InputTextResetTextAFromTextW(ImGuiInputTextState* state, int min_capacity);
 
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Text, etc.
@@ -146,7 +151,126 @@ static ImVec2   InputTextCalcTextSizeW(ImGuiContext* ctx, const ImWchar* text_be
 // - BulletTextV()
 //-------------------------------------------------------------------------
 
-void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
+// Update line index and layout data of a large text block.
+// Only lines added since last call are measured, unless font, font size, wrap width or 'measure_width' changed.
+static void TextBlockIndexUpdate(ImGuiTextBlockIndex* index, const char* text, const char* text_end, float wrap_width, bool measure_width)
+{
+    ImGuiContext& g = *GImGui;
+    const int text_size = (int)(text_end - text);
+    if (index->TextBegin != text || text_size < index->Lines.EndOffset)
+        index->clear();
+    index->TextBegin = text;
+    if (index->LayoutFont != g.Font || index->LayoutFontSize != g.FontSize || index->LayoutWrapWidth != wrap_width || index->LayoutMeasureWidth != measure_width)
+    {
+        index->clear_layout();
+        index->LayoutFont = g.Font;
+        index->LayoutFontSize = g.FontSize;
+        index->LayoutWrapWidth = wrap_width;
+        index->LayoutMeasureWidth = measure_width;
+    }
+    if (text_size > index->Lines.EndOffset)
+    {
+        index->Lines.append(text, index->Lines.EndOffset, text_size);
+        if (index->LayoutLinesCount > 0) // Last line may have been extended: measure it again
+            index->LayoutLinesCount--;
+    }
+    if (!measure_width && wrap_width <= 0.0f)
+    {
+        index->LayoutLinesCount = index->Lines.size();
+        return;
+    }
+
+    index->WrapLinesPrefix.resize(index->LayoutLinesCount + 1);
+    index->WrapLinesPrefix[0] = 0;
+    for (int line_n = index->LayoutLinesCount; line_n < index->Lines.size(); line_n++)
+    {
+        const char* line_begin = index->Lines.get_line_begin(text, line_n);
+        const char* line_end = index->Lines.get_line_end(text, line_n);
+        const ImVec2 line_size = g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, wrap_width, line_begin, line_end);
+        index->LayoutMaxWidth = ImMax(index->LayoutMaxWidth, IM_TRUNC(line_size.x + 0.99999f)); // Same rounding as CalcTextSize()
+        index->WrapLinesPrefix.push_back(index->WrapLinesPrefix[line_n] + ImMax((int)(line_size.y / g.FontSize + 0.5f), 1));
+    }
+    index->LayoutLinesCount = index->Lines.size();
+}
+
+// Render a large text block using a line index: cost depends on visible lines, plus lines added since last call.
+static void TextExWithLineIndex(const char* text, const char* text_end, ImGuiTextFlags flags, ImGuiTextBlockIndex* index)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+    const float wrap_pos_x = window->DC.TextWrapPos;
+    const bool wrap_enabled = (wrap_pos_x >= 0.0f);
+    const float wrap_width = wrap_enabled ? ImGui::CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.0f;
+    const bool measure_width = (flags & ImGuiTextFlags_NoWidthForLargeClippedText) == 0;
+    const float line_height = g.FontSize;
+    index->LastFrameActive = g.FrameCount;
+    TextBlockIndexUpdate(index, text, text_end, wrap_width, measure_width);
+
+    // Find visible lines. When wrapping, source line containing first visible visual line is found with a binary search.
+    const int lines_count = index->Lines.size();
+    const int visual_lines_count = wrap_enabled ? index->WrapLinesPrefix[lines_count] : lines_count;
+    const int visual_line_min = ImClamp((int)ImFloor((window->ClipRect.Min.y - text_pos.y) / line_height), 0, visual_lines_count);
+    const int visual_line_max = ImClamp((int)ImCeil((window->ClipRect.Max.y - text_pos.y) / line_height), visual_line_min, visual_lines_count);
+    int line_min = visual_line_min;
+    if (wrap_enabled)
+    {
+        int lo = 0, hi = lines_count - 1;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi + 1) / 2;
+            if (index->WrapLinesPrefix[mid] <= visual_line_min)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        line_min = lo;
+    }
+
+    // Verify that visible lines are still delimited by line breaks, otherwise text was modified: rebuild index.
+    for (int line_n = line_min; line_n < lines_count && (wrap_enabled ? index->WrapLinesPrefix[line_n] : line_n) < visual_line_max; line_n++)
+        if ((line_n > 0 && text[index->Lines.LineOffsets[line_n] - 1] != '\n') || (line_n + 1 < lines_count && memchr(index->Lines.get_line_begin(text, line_n), '\n', index->Lines.get_line_end(text, line_n) - index->Lines.get_line_begin(text, line_n)) != NULL))
+        {
+            index->clear();
+            TextExWithLineIndex(text, text_end, flags, index);
+            return;
+        }
+
+    // Render visible lines
+    ImVec2 text_size(measure_width ? index->LayoutMaxWidth : 0.0f, visual_lines_count * line_height);
+    for (int line_n = line_min; line_n < lines_count; line_n++)
+    {
+        int visual_line_n = wrap_enabled ? index->WrapLinesPrefix[line_n] : line_n;
+        if (visual_line_n >= visual_line_max)
+            break;
+        const char* line_begin = index->Lines.get_line_begin(text, line_n);
+        const char* line_end = index->Lines.get_line_end(text, line_n);
+        if (wrap_enabled)
+        {
+            // Skip wrapped lines above clipping rectangle (same logic as ImFont::CalcTextSizeA() and ImFont::RenderText())
+            const float scale = g.FontSize / g.Font->FontSize;
+            for (; visual_line_n < visual_line_min && line_begin < line_end; visual_line_n++)
+            {
+                line_begin = g.Font->CalcWordWrapPositionA(scale, line_begin, line_end, wrap_width);
+                while (line_begin < line_end && ImCharIsBlankA(*line_begin))
+                    line_begin++;
+            }
+            ImGui::RenderTextWrapped(ImVec2(text_pos.x, text_pos.y + visual_line_n * line_height), line_begin, line_end, wrap_width);
+        }
+        else
+        {
+            if (!measure_width)
+                text_size.x = ImMax(text_size.x, ImGui::CalcTextSize(line_begin, line_end).x);
+            ImGui::RenderText(ImVec2(text_pos.x, text_pos.y + visual_line_n * line_height), line_begin, line_end, false);
+        }
+    }
+
+    ImRect bb(text_pos, text_pos + text_size);
+    ImGui::ItemSize(text_size, 0.0f);
+    ImGui::ItemAdd(bb, 0);
+}
+
+void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags, ImGuiTextBlockIndex* line_index)
 {
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
@@ -162,6 +286,31 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
     if (text_end == NULL)
         text_end = text + strlen(text); // FIXME-OPT
 
+    // Large text: use line index provided by caller, or one stored in context and identified by text pointer.
+    // (can't skip lines when logging text. Formatted text in g.TempBuffer is not indexed as it is rewritten every frame)
+    // Context-owned indices are discarded by NewFrame() when not used during the previous frame.
+    if (line_index == NULL && text_end - text >= TEXT_LINE_INDEX_MIN_SIZE && !(text >= g.TempBuffer.Data && text < g.TempBuffer.Data + g.TempBuffer.Size))
+    {
+        const ImGuiID key = ImHashData(&text, sizeof(text));
+        line_index = (ImGuiTextBlockIndex*)g.TextBlockIndicesMap.GetVoidPtr(key);
+        if (line_index == NULL)
+        {
+            line_index = IM_NEW(ImGuiTextBlockIndex)();
+            line_index->TextBegin = text;
+            g.TextBlockIndices.push_back(line_index);
+            g.TextBlockIndicesMap.SetVoidPtr(key, line_index);
+        }
+        else if (line_index->TextBegin != text) // Hash collision with another live text block: don't use an index
+        {
+            line_index = NULL;
+        }
+    }
+    if (line_index != NULL && !g.LogEnabled)
+    {
+        TextExWithLineIndex(text, text_end, flags, line_index);
+        return;
+    }
+
     const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
     const float wrap_pos_x = window->DC.TextWrapPos;
     const bool wrap_enabled = (wrap_pos_x >= 0.0f);
@@ -1887,11 +2036,25 @@ static const char* Items_ArrayGetter(void* data, int idx)
 }
 
 // Getter for the old Combo() API: "item1\0item2\0item3\0"
+// Remember the last item we found so increasing indices (as submitted by the clipper) don't rescan from the start.
+struct ImGuiComboSingleStringData
+{
+    const char* Items;
+    const char* LastItem;
+    int         LastIdx;
+    ImGuiComboSingleStringData(const char* items) { Items = LastItem = items; LastIdx = 0; }
+};
+
 static const char* Items_SingleStringGetter(void* data, int idx)
 {
-    const char* items_separated_by_zeros = (const char*)data;
+    ImGuiComboSingleStringData* items_data = (ImGuiComboSingleStringData*)data;
     int items_count = 0;
-    const char* p = items_separated_by_zeros;
+    const char* p = items_data->Items;
+    if (idx >= items_data->LastIdx)
+    {
+        items_count = items_data->LastIdx;
+        p = items_data->LastItem;
+    }
     while (*p)
     {
         if (idx == items_count)
@@ -1899,9 +2062,60 @@ static const char* Items_SingleStringGetter(void* data, int idx)
         p += strlen(p) + 1;
         items_count++;
     }
+    items_data->LastItem = p;
+    items_data->LastIdx = items_count;
     return *p ? p : NULL;
 }
 
+// Display items of an open combo popup.
+// Items are clipped, except the current one which needs to be submitted on the appearing frame for SetItemDefaultFocus() to focus and scroll to it.
+// The popup is auto-resized, so we measure all items when it appears (or when their count changes) to fit its width to all of them, not only to visible ones.
+static bool ComboItemsEx(int* current_item, const char* (*getter)(void* user_data, int idx), void* user_data, int items_count)
+{
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImGuiStorage* storage = ImGui::GetStateStorage();
+    const ImGuiID items_width_id = window->GetID("##ItemsWidth");
+    const ImGuiID items_count_id = window->GetID("##ItemsCount");
+    float items_width = storage->GetFloat(items_width_id, -1.0f);
+    if (items_width < 0.0f || ImGui::IsWindowAppearing() || storage->GetInt(items_count_id, -1) != items_count)
+    {
+        items_width = 0.0f;
+        for (int i = 0; i < items_count; i++)
+        {
+            const char* item_text = getter(user_data, i);
+            items_width = ImMax(items_width, ImGui::CalcTextSize(item_text ? item_text : "*Unknown item*", NULL, true).x);
+        }
+        storage->SetFloat(items_width_id, items_width);
+        storage->SetInt(items_count_id, items_count);
+    }
+    window->DC.CursorMaxPos.x = ImMax(window->DC.CursorMaxPos.x, window->DC.CursorPos.x + items_width);
+
+    bool value_changed = false;
+    ImGuiListClipper clipper;
+    clipper.Begin(items_count, ImGui::GetTextLineHeightWithSpacing());
+    if (*current_item >= 0 && *current_item < items_count)
+        clipper.IncludeItemByIndex(*current_item);
+    while (clipper.Step())
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+        {
+            const char* item_text = getter(user_data, i);
+            if (item_text == NULL)
+                item_text = "*Unknown item*";
+
+            ImGui::PushID(i);
+            const bool item_selected = (i == *current_item);
+            if (ImGui::Selectable(item_text, item_selected) && *current_item != i)
+            {
+                value_changed = true;
+                *current_item = i;
+            }
+            if (item_selected)
+                ImGui::SetItemDefaultFocus();
+            ImGui::PopID();
+        }
+    return value_changed;
+}
+
 // Old API, prefer using BeginCombo() nowadays if you can.
 bool ImGui::Combo(const char* label, int* current_item, const char* (*getter)(void* user_data, int idx), void* user_data, int items_count, int popup_max_height_in_items)
 {
@@ -1920,25 +2134,7 @@ bool ImGui::Combo(const char* label, int* current_item, const char* (*getter)(vo
         return false;
 
     // Display items
-    // FIXME-OPT: Use clipper (but we need to disable it on the appearing frame to make sure our call to SetItemDefaultFocus() is processed)
-    bool value_changed = false;
-    for (int i = 0; i < items_count; i++)
-    {
-        const char* item_text = getter(user_data, i);
-        if (item_text == NULL)
-            item_text = "*Unknown item*";
-
-        PushID(i);
-        const bool item_selected = (i == *current_item);
-        if (Selectable(item_text, item_selected) && *current_item != i)
-        {
-            value_changed = true;
-            *current_item = i;
-        }
-        if (item_selected)
-            SetItemDefaultFocus();
-        PopID();
-    }
+    bool value_changed = ComboItemsEx(current_item, getter, user_data, items_count);
 
     EndCombo();
 
@@ -1956,16 +2152,29 @@ bool ImGui::Combo(const char* label, int* current_item, const char* const items[
 }
 
 // Combo box helper allowing to pass all items in a single string literal holding multiple zero-terminated items "item1\0item2\0"
+// Items are only counted while the popup is open, otherwise we only scan up to the current item for the preview.
 bool ImGui::Combo(const char* label, int* current_item, const char* items_separated_by_zeros, int height_in_items)
 {
-    int items_count = 0;
-    const char* p = items_separated_by_zeros;       // FIXME-OPT: Avoid computing this, or at least only when combo is open
-    while (*p)
-    {
-        p += strlen(p) + 1;
-        items_count++;
-    }
-    bool value_changed = Combo(label, current_item, Items_SingleStringGetter, (void*)items_separated_by_zeros, items_count, height_in_items);
+    ImGuiContext& g = *GImGui;
+    ImGuiComboSingleStringData items_data(items_separated_by_zeros);
+    const char* preview_value = (*current_item >= 0) ? Items_SingleStringGetter(&items_data, *current_item) : NULL;
+
+    if (height_in_items != -1 && !(g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint))
+        SetNextWindowSizeConstraints(ImVec2(0, 0), ImVec2(FLT_MAX, CalcMaxPopupHeightFromItemCount(height_in_items)));
+
+    if (!BeginCombo(label, preview_value, ImGuiComboFlags_None))
+        return false;
+
+    // Count items, resuming from the preview item
+    Items_SingleStringGetter(&items_data, INT_MAX);
+    const int items_count = items_data.LastIdx;
+    bool value_changed = ComboItemsEx(current_item, Items_SingleStringGetter, &items_data, items_count);
+
+    EndCombo();
+
+    if (value_changed)
+        MarkItemEdited(g.LastItemData.ID);
+
     return value_changed;
 }
 
@@ -3658,49 +3867,73 @@ static int InputTextCalcTextLenAndLineCount(const char* text_begin, const char**
     return line_count;
 }
 
-static ImVec2 InputTextCalcTextSizeW(ImGuiContext* ctx, const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining, ImVec2* out_offset, bool stop_on_new_line)
+// Measure a line of the edit buffer from 'idx_begin', up to 'idx_end' or until after the first \n.
+static float InputTextCalcLineWidthW(ImGuiInputTextState* state, int idx_begin, int idx_end, int* out_idx_remaining)
 {
-    ImGuiContext& g = *ctx;
+    ImGuiContext& g = *state->Ctx;
     ImFont* font = g.Font;
-    const float line_height = g.FontSize;
-    const float scale = line_height / font->FontSize;
+    const float scale = g.FontSize / font->FontSize;
 
-    ImVec2 text_size = ImVec2(0, 0);
     float line_width = 0.0f;
-
-    const ImWchar* s = text_begin;
-    while (s < text_end)
+    int idx = idx_begin;
+    while (idx < idx_end)
     {
-        unsigned int c = (unsigned int)(*s++);
+        unsigned int c = (unsigned int)state->GetCharW(idx++);
         if (c == '\n')
-        {
-            text_size.x = ImMax(text_size.x, line_width);
-            text_size.y += line_height;
-            line_width = 0.0f;
-            if (stop_on_new_line)
-                break;
-            continue;
-        }
+            break;
         if (c == '\r')
             continue;
-
-        const float char_width = font->GetCharAdvance((ImWchar)c) * scale;
-        line_width += char_width;
+        line_width += font->GetCharAdvance((ImWchar)c) * scale;
     }
+    if (out_idx_remaining)
+        *out_idx_remaining = idx;
+    return line_width;
+}
 
-    if (text_size.x < line_width)
-        text_size.x = line_width;
-
-    if (out_offset)
-        *out_offset = ImVec2(line_width, text_size.y + line_height);  // offset allow for the possibility of sitting after a trailing \n
+// Helpers to convert a range of the edit buffer to UTF-8, processing the contiguous runs on each side of the gap.
+static int InputTextCountUtf8BytesW(const ImGuiInputTextState* state, int idx_begin, int idx_end)
+{
+    const ImWchar* text = state->TextW.Data;
+    const int gap_len = state->GetGapLenW();
+    const int gap_pos = state->GapPosW;
+    int bytes_count = 0;
+    if (idx_begin < gap_pos)
+        bytes_count += ImTextCountUtf8BytesFromStr(text + idx_begin, text + ImMin(idx_end, gap_pos));
+    if (idx_end > gap_pos)
+        bytes_count += ImTextCountUtf8BytesFromStr(text + ImMax(idx_begin, gap_pos) + gap_len, text + idx_end + gap_len);
+    return bytes_count;
+}
 
-    if (line_width > 0 || text_size.y == 0.0f)                        // whereas size.y will ignore the trailing \n
-        text_size.y += line_height;
+static int InputTextStrToUtf8W(const ImGuiInputTextState* state, char* out_buf, int out_buf_size, int idx_begin, int idx_end)
+{
+    const ImWchar* text = state->TextW.Data;
+    const int gap_len = state->GetGapLenW();
+    const int gap_pos = state->GapPosW;
+    int bytes_count = 0;
+    out_buf[0] = 0;
+    if (idx_begin < gap_pos)
+        bytes_count += ImTextStrToUtf8(out_buf, out_buf_size, text + idx_begin, text + ImMin(idx_end, gap_pos));
+    if (idx_end > gap_pos)
+        bytes_count += ImTextStrToUtf8(out_buf + bytes_count, out_buf_size - bytes_count, text + ImMax(idx_begin, gap_pos) + gap_len, text + idx_end + gap_len);
+    return bytes_count;
+}
 
-    if (remaining)
-        *remaining = s;
+// Convert contiguous TextW back to TextA so they exactly match (malformed UTF-8 input has been cut off or replaced), edits then keep them in sync.
+static void InputTextResetTextAFromTextW(ImGuiInputTextState* state, int min_capacity)
+{
+    const ImWchar* text = state->TextW.Data;
+    state->TextA.resize(ImMax(min_capacity, ImTextCountUtf8BytesFromStr(text, text + state->CurLenW) + 1));
+    state->CurLenA = ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, text, text + state->CurLenW);
+    state->TextAIsValid = true;
+    state->SetGapAtEndW();
+}
 
-    return text_size;
+// Convert a position in the edit buffer to an offset in TextA, counting from the gap which is usually near the cursor.
+static int InputTextGetUtf8OffsetW(const ImGuiInputTextState* state, int idx)
+{
+    if (idx < state->GapPosW)
+        return state->GapPosA - InputTextCountUtf8BytesW(state, idx, state->GapPosW);
+    return state->GapPosA + InputTextCountUtf8BytesW(state, state->GapPosW, idx);
 }
 
 // Wrapper for stb_textedit.h to edit text (our wrapper is for: statically sized buffer, single-line, wchar characters. InputText converts between UTF-8 and wchar)
@@ -3708,21 +3941,19 @@ namespace ImStb
 {
 
 static int     STB_TEXTEDIT_STRINGLEN(const ImGuiInputTextState* obj)                             { return obj->CurLenW; }
-static ImWchar STB_TEXTEDIT_GETCHAR(const ImGuiInputTextState* obj, int idx)                      { IM_ASSERT(idx <= obj->CurLenW); return obj->TextW[idx]; }
-static float   STB_TEXTEDIT_GETWIDTH(ImGuiInputTextState* obj, int line_start_idx, int char_idx)  { ImWchar c = obj->TextW[line_start_idx + char_idx]; if (c == '\n') return IMSTB_TEXTEDIT_GETWIDTH_NEWLINE; ImGuiContext& g = *obj->Ctx; return g.Font->GetCharAdvance(c) * (g.FontSize / g.Font->FontSize); }
+static ImWchar STB_TEXTEDIT_GETCHAR(const ImGuiInputTextState* obj, int idx)                      { return obj->GetCharW(idx); }
+static float   STB_TEXTEDIT_GETWIDTH(ImGuiInputTextState* obj, int line_start_idx, int char_idx)  { ImWchar c = obj->GetCharW(line_start_idx + char_idx); if (c == '\n') return IMSTB_TEXTEDIT_GETWIDTH_NEWLINE; ImGuiContext& g = *obj->Ctx; return g.Font->GetCharAdvance(c) * (g.FontSize / g.Font->FontSize); }
 static int     STB_TEXTEDIT_KEYTOTEXT(int key)                                                    { return key >= 0x200000 ? 0 : key; }
 static ImWchar STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, ImGuiInputTextState* obj, int line_start_idx)
 {
-    const ImWchar* text = obj->TextW.Data;
-    const ImWchar* text_remaining = NULL;
-    const ImVec2 size = InputTextCalcTextSizeW(obj->Ctx, text + line_start_idx, text + obj->CurLenW, &text_remaining, NULL, true);
+    int line_end_idx = line_start_idx;
     r->x0 = 0.0f;
-    r->x1 = size.x;
-    r->baseline_y_delta = size.y;
+    r->x1 = InputTextCalcLineWidthW(obj, line_start_idx, obj->CurLenW, &line_end_idx);
+    r->baseline_y_delta = obj->Ctx->FontSize;
     r->ymin = 0.0f;
-    r->ymax = size.y;
-    r->num_chars = (int)(text_remaining - (text + line_start_idx));
+    r->ymax = obj->Ctx->FontSize;
+    r->num_chars = line_end_idx - line_start_idx;
 }
 
 static bool is_separator(unsigned int c)
@@ -3736,10 +3967,10 @@ static int is_word_boundary_from_right(ImGuiInputTextState* obj, int idx)
     if ((obj->Flags & ImGuiInputTextFlags_Password) || idx <= 0)
         return 0;
 
-    bool prev_white = ImCharIsBlankW(obj->TextW[idx - 1]);
-    bool prev_separ = is_separator(obj->TextW[idx - 1]);
-    bool curr_white = ImCharIsBlankW(obj->TextW[idx]);
-    bool curr_separ = is_separator(obj->TextW[idx]);
+    bool prev_white = ImCharIsBlankW(obj->GetCharW(idx - 1));
+    bool prev_separ = is_separator(obj->GetCharW(idx - 1));
+    bool curr_white = ImCharIsBlankW(obj->GetCharW(idx));
+    bool curr_separ = is_separator(obj->GetCharW(idx));
     return ((prev_white || prev_separ) && !(curr_separ || curr_white)) || (curr_separ && !prev_separ);
 }
 static int is_word_boundary_from_left(ImGuiInputTextState* obj, int idx)
@@ -3747,10 +3978,10 @@ static int is_word_boundary_from_left(ImGuiInputTextState* obj, int idx)
     if ((obj->Flags & ImGuiInputTextFlags_Password) || idx <= 0)
         return 0;
 
-    bool prev_white = ImCharIsBlankW(obj->TextW[idx]);
-    bool prev_separ = is_separator(obj->TextW[idx]);
-    bool curr_white = ImCharIsBlankW(obj->TextW[idx - 1]);
-    bool curr_separ = is_separator(obj->TextW[idx - 1]);
+    bool prev_white = ImCharIsBlankW(obj->GetCharW(idx));
+    bool prev_separ = is_separator(obj->GetCharW(idx));
+    bool curr_white = ImCharIsBlankW(obj->GetCharW(idx - 1));
+    bool curr_separ = is_separator(obj->GetCharW(idx - 1));
     return ((prev_white) && !(curr_separ || curr_white)) || (curr_separ && !prev_separ);
 }
 static int  STB_TEXTEDIT_MOVEWORDLEFT_IMPL(ImGuiInputTextState* obj, int idx)   { idx--; while (idx >= 0 && !is_word_boundary_from_right(obj, idx)) idx--; return idx < 0 ? 0 : idx; }
@@ -3760,20 +3991,44 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(ImGuiInputTextState* obj, int idx)
 #define STB_TEXTEDIT_MOVEWORDLEFT   STB_TEXTEDIT_MOVEWORDLEFT_IMPL  // They need to be #define for stb_textedit.h
 #define STB_TEXTEDIT_MOVEWORDRIGHT  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL
 
-static void STB_TEXTEDIT_DELETECHARS(ImGuiInputTextState* obj, int pos, int n)
+// Rows are lines (we don't do word-wrapping), so we can use the line index to skip rows instead of laying them out from the start of text.
+// We stop one row early so stb_textedit.h still does the final comparisons.
+static void STB_TEXTEDIT_SEEKROW_Y_IMPL(ImGuiInputTextState* obj, float y, int* out_row_start, float* out_row_y)
+{
+    const int line_no = ImClamp((int)(y / obj->Ctx->FontSize) - 1, 0, obj->GetLineCount() - 1);
+    *out_row_start = obj->GetLineStartW(line_no);
+    *out_row_y = line_no * obj->Ctx->FontSize;
+}
+static void STB_TEXTEDIT_SEEKROW_CHAR_IMPL(ImGuiInputTextState* obj, int n, int* out_row_start, float* out_row_y, int* out_prev_row_start)
 {
-    ImWchar* dst = obj->TextW.Data + pos;
+    const int line_no = ImMax(obj->GetLineFromIdxW(n) - 1, 0);
+    *out_row_start = obj->GetLineStartW(line_no);
+    *out_row_y = line_no * obj->Ctx->FontSize;
+    *out_prev_row_start = obj->GetLineStartW(ImMax(line_no - 1, 0));
+}
+#define IMSTB_TEXTEDIT_SEEKROW_Y    STB_TEXTEDIT_SEEKROW_Y_IMPL
+#define IMSTB_TEXTEDIT_SEEKROW_CHAR STB_TEXTEDIT_SEEKROW_CHAR_IMPL
 
-    // We maintain our buffer length in both UTF-8 and wchar formats
+static void STB_TEXTEDIT_DELETECHARS(ImGuiInputTextState* obj, int pos, int n)
+{
+    // Move the gap to 'pos' then extend it over the deleted characters
+    obj->MoveGapW(pos);
+    const ImWchar* deleted = obj->TextW.Data + pos + obj->GetGapLenW();
+    const int deleted_len_utf8 = ImTextCountUtf8BytesFromStr(deleted, deleted + n);
+
+    // Deleted '\n' are the ones nearest to the gap in the line index
+    const int line_count = obj->GetLineCount();
+    for (int i = 0; i < n; i++)
+        if (deleted[i] == '\n')
+            obj->NewlinesAfterGap.pop_back();
+    obj->SetColorDirtyLines(obj->NewlinesBeforeGap.Size, (obj->GetLineCount() != line_count) ? INT_MAX : obj->NewlinesBeforeGap.Size);
+
+    // We maintain our buffer in both UTF-8 and wchar formats
+    char* text_a = obj->TextA.Data + obj->GapPosA;
+    memmove(text_a, text_a + deleted_len_utf8, (size_t)(obj->CurLenA - obj->GapPosA - deleted_len_utf8 + 1));
     obj->Edited = true;
-    obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
+    obj->CurLenA -= deleted_len_utf8;
     obj->CurLenW -= n;
-
-    // Offset remaining text (FIXME-OPT: Use memmove)
-    const ImWchar* src = obj->TextW.Data + pos + n;
-    while (ImWchar c = *src++)
-        *dst++ = c;
-    *dst = '\0';
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const ImWchar* new_text, int new_text_len)
@@ -3787,23 +4042,44 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const Im
         return false;
 
     // Grow internal buffer if needed
-    if (new_text_len + text_len + 1 > obj->TextW.Size)
+    if (new_text_len > obj->GetGapLenW())
     {
         if (!is_resizable)
             return false;
-        IM_ASSERT(text_len < obj->TextW.Size);
-        obj->TextW.resize(text_len + ImClamp(new_text_len * 4, 32, ImMax(256, new_text_len)) + 1);
+        obj->ReserveGapW(ImClamp(new_text_len * 4, 32, ImMax(256, new_text_len)));
     }
 
-    ImWchar* text = obj->TextW.Data;
-    if (pos != text_len)
-        memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
-    memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
+    if (obj->CurLenA + new_text_len_utf8 + 1 > obj->TextA.Size)
+        obj->TextA.resize(obj->TextA._grow_capacity(obj->CurLenA + new_text_len_utf8 + 1));
+
+    // Move the gap to 'pos' and fill its beginning
+    obj->MoveGapW(pos);
+    memcpy(obj->TextW.Data + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
+
+    // Same in UTF-8 buffer. ImTextStrToUtf8() writes a zero-terminator, restore the character it overwrites.
+    char* text_a = obj->TextA.Data + obj->GapPosA;
+    memmove(text_a + new_text_len_utf8, text_a, (size_t)(obj->CurLenA - obj->GapPosA + 1));
+    const char c_after = text_a[new_text_len_utf8];
+    ImTextStrToUtf8(text_a, new_text_len_utf8 + 1, new_text, new_text + new_text_len);
+    text_a[new_text_len_utf8] = c_after;
+
+    // Inserted '\n' go before the gap in the line index
+    const int line_no = obj->NewlinesBeforeGap.Size;
+    for (int i = 0, offset_a = obj->GapPosA, last_i = 0; i < new_text_len; i++)
+        if (new_text[i] == '\n')
+        {
+            offset_a += ImTextCountUtf8BytesFromStr(new_text + last_i, new_text + i);
+            last_i = i;
+            ImGuiInputTextNewline newline = { pos + i, offset_a };
+            obj->NewlinesBeforeGap.push_back(newline);
+        }
+    obj->SetColorDirtyLines(line_no, (obj->NewlinesBeforeGap.Size != line_no) ? INT_MAX : line_no);
 
     obj->Edited = true;
+    obj->GapPosW += new_text_len;
+    obj->GapPosA += new_text_len_utf8;
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
-    obj->TextW[obj->CurLenW] = '\0';
 
     return true;
 }
@@ -3829,6 +4105,8 @@ static bool STB_TEXTEDIT_INSERTCHARS(ImGuiInputTextState* obj, int pos, const Im
 
 #define IMSTB_TEXTEDIT_IMPLEMENTATION
 #define IMSTB_TEXTEDIT_memmove memmove
+#define IMSTB_TEXTEDIT_malloc(sz) IM_ALLOC(sz)
+#define IMSTB_TEXTEDIT_free(p)    IM_FREE(p)
 #include "imstb_textedit.h"
 
 // stb_textedit internally allows for a single undo record to do addition and deletion, but somehow, calling
@@ -3858,6 +4136,109 @@ void ImGuiInputTextState::OnKeyPressed(int key)
     CursorAnimReset();
 }
 
+void ImGuiInputTextState::ClearFreeMemory()
+{
+    TextW.clear();
+    TextA.clear();
+    InitialTextA.clear();
+    NewlinesBeforeGap.clear();
+    NewlinesAfterGap.clear();
+    ColorLines.clear();
+    ColorSpans.clear();
+    GapPosW = GapPosA = 0;
+    stb_textedit_free_undo(&Stb.undostate);
+}
+
+void ImGuiInputTextState::SetGapAtEndW()
+{
+    GapPosW = CurLenW;
+    GapPosA = CurLenA;
+    TextW.Data[TextW.Size - 1] = 0;
+
+    // Rebuild line index
+    NewlinesBeforeGap.resize(0);
+    NewlinesAfterGap.resize(0);
+    SetColorDirtyLines(0, INT_MAX);
+    for (const char* p = TextA.Data; (p = (const char*)memchr(p, '\n', (size_t)(TextA.Data + CurLenA - p))) != NULL; p++)
+    {
+        ImGuiInputTextNewline newline = { 0, (int)(p - TextA.Data) };
+        NewlinesBeforeGap.push_back(newline);
+    }
+    for (int n = 0, idx = 0; n < NewlinesBeforeGap.Size; n++, idx++)
+    {
+        while (TextW.Data[idx] != '\n')
+            idx++;
+        NewlinesBeforeGap[n].IdxW = idx;
+    }
+}
+
+// Move the gap so it starts at 'pos'. Cost is proportional to the distance moved, which is small when editing around the cursor.
+void ImGuiInputTextState::MoveGapW(int pos)
+{
+    IM_ASSERT(pos >= 0 && pos <= CurLenW);
+    const int gap_len = GetGapLenW();
+    if (pos < GapPosW)
+    {
+        GapPosA -= ImTextCountUtf8BytesFromStr(TextW.Data + pos, TextW.Data + GapPosW);
+        memmove(TextW.Data + pos + gap_len, TextW.Data + pos, (size_t)(GapPosW - pos) * sizeof(ImWchar));
+        while (NewlinesBeforeGap.Size > 0 && NewlinesBeforeGap.back().IdxW >= pos)
+        {
+            ImGuiInputTextNewline newline = { CurLenW - NewlinesBeforeGap.back().IdxW, CurLenA - NewlinesBeforeGap.back().OffsetA };
+            NewlinesAfterGap.push_back(newline);
+            NewlinesBeforeGap.pop_back();
+        }
+    }
+    else if (pos > GapPosW)
+    {
+        GapPosA += ImTextCountUtf8BytesFromStr(TextW.Data + GapPosW + gap_len, TextW.Data + pos + gap_len);
+        memmove(TextW.Data + GapPosW, TextW.Data + GapPosW + gap_len, (size_t)(pos - GapPosW) * sizeof(ImWchar));
+        while (NewlinesAfterGap.Size > 0 && CurLenW - NewlinesAfterGap.back().IdxW < pos)
+        {
+            ImGuiInputTextNewline newline = { CurLenW - NewlinesAfterGap.back().IdxW, CurLenA - NewlinesAfterGap.back().OffsetA };
+            NewlinesBeforeGap.push_back(newline);
+            NewlinesAfterGap.pop_back();
+        }
+    }
+    GapPosW = pos;
+}
+
+ImGuiInputTextNewline ImGuiInputTextState::GetNewline(int n) const
+{
+    IM_ASSERT(n >= 0 && n < NewlinesBeforeGap.Size + NewlinesAfterGap.Size);
+    if (n < NewlinesBeforeGap.Size)
+        return NewlinesBeforeGap.Data[n];
+    const ImGuiInputTextNewline& rel = NewlinesAfterGap.Data[NewlinesAfterGap.Size - 1 - (n - NewlinesBeforeGap.Size)];
+    ImGuiInputTextNewline newline = { CurLenW - rel.IdxW, CurLenA - rel.OffsetA };
+    return newline;
+}
+
+int ImGuiInputTextState::GetLineFromIdxW(int idx) const
+{
+    // Binary search for the number of '\n' before 'idx'
+    int count_lo = 0, count_hi = NewlinesBeforeGap.Size + NewlinesAfterGap.Size;
+    while (count_lo < count_hi)
+    {
+        const int mid = (count_lo + count_hi) >> 1;
+        if (GetNewline(mid).IdxW < idx)
+            count_lo = mid + 1;
+        else
+            count_hi = mid;
+    }
+    return count_lo;
+}
+
+// Grow the buffer so the gap can hold at least 'len' characters, moving the text after the gap (and zero-terminator) to the new end.
+void ImGuiInputTextState::ReserveGapW(int len)
+{
+    const int gap_len = GetGapLenW();
+    if (gap_len >= len)
+        return;
+    const int after_gap_len = CurLenW - GapPosW + 1;
+    const int old_size = TextW.Size;
+    TextW.resize(TextW._grow_capacity(old_size + len - gap_len));
+    memmove(TextW.Data + TextW.Size - after_gap_len, TextW.Data + old_size - after_gap_len, (size_t)after_gap_len * sizeof(ImWchar));
+}
+
 ImGuiInputTextCallbackData::ImGuiInputTextCallbackData()
 {
     memset(this, 0, sizeof(*this));
@@ -3920,6 +4301,141 @@ void ImGuiInputTextCallbackData::InsertChars(int pos, const char* new_text, cons
     BufTextLen += new_text_len;
 }
 
+void ImGuiInputTextCallbackData::AddColorSpan(int pos, int bytes_count, ImU32 col)
+{
+    IM_ASSERT(EventFlag == ImGuiInputTextFlags_CallbackColor);
+    IM_ASSERT(pos >= 0 && bytes_count >= 0 && pos + bytes_count <= BufTextLen);
+    ImGuiContext& g = *Ctx;
+    ImGuiInputTextColorSpan span = { pos, pos + bytes_count, col };
+    g.InputTextColorSpans.push_back(span);
+}
+
+// Render visible lines of multi-line text, colored by ImGuiInputTextFlags_CallbackColor callback.
+// When 'state' is provided (active widget displaying state->TextA), we use the line index to find the first visible line and
+// cache color spans of visible lines until they are edited. Otherwise we call the callback for visible lines every frame.
+static void InputTextRenderColoredLines(ImGuiContext* ctx, ImGuiInputTextState* state, ImDrawList* draw_list, const ImVec2& pos, const ImVec4& clip_rect, ImU32 col, const char* text, const char* text_end, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data)
+{
+    ImGuiContext& g = *ctx;
+    const float line_height = g.FontSize;
+    const int line_min = ImMax((int)((clip_rect.y - pos.y) / line_height) - 1, 0);
+    const int line_max = ImMax((int)((clip_rect.w - pos.y) / line_height) + 1, line_min);
+
+    if (state != NULL)
+    {
+        // Drop cached lines which have been edited or are out of view
+        int live_lines = 0, live_spans = 0;
+        for (int n = 0; n < state->ColorLines.Size; n++)
+        {
+            const ImGuiInputTextColorLine& entry = state->ColorLines[n];
+            if (entry.Line < line_min || entry.Line > line_max || (entry.Line >= state->ColorDirtyLineMin && entry.Line <= state->ColorDirtyLineMax))
+                continue;
+            state->ColorLines[live_lines++] = entry;
+            live_spans += entry.SpansCount;
+        }
+        state->ColorLines.resize(live_lines);
+        state->ColorDirtyLineMin = INT_MAX;
+        state->ColorDirtyLineMax = -1;
+
+        // Compact spans storage, using the callback output buffer as temporary storage
+        if (state->ColorSpans.Size > live_spans * 2 + 256)
+        {
+            ImVector<ImGuiInputTextColorSpan>& spans = g.InputTextColorSpans;
+            spans.resize(0);
+            spans.reserve(live_spans);
+            for (int n = 0; n < state->ColorLines.Size; n++)
+            {
+                ImGuiInputTextColorLine& entry = state->ColorLines[n];
+                spans.resize(spans.Size + entry.SpansCount);
+                memcpy(spans.Data + spans.Size - entry.SpansCount, state->ColorSpans.Data + entry.SpansStart, (size_t)entry.SpansCount * sizeof(ImGuiInputTextColorSpan));
+                entry.SpansStart = spans.Size - entry.SpansCount;
+            }
+            state->ColorSpans.swap(spans);
+        }
+    }
+
+    // Find first visible line
+    int line_no = 0;
+    const char* line_begin = text;
+    if (state != NULL)
+    {
+        line_no = ImMin(line_min, state->GetLineCount() - 1);
+        line_begin = text + state->GetLineStartA(line_no);
+    }
+    else
+    {
+        for (const char* p; line_no < line_min && (p = (const char*)memchr(line_begin, '\n', (size_t)(text_end - line_begin))) != NULL; line_no++)
+            line_begin = p + 1;
+    }
+
+    for (int cache_n = 0; line_no <= line_max; line_no++)
+    {
+        const char* line_end = (const char*)memchr(line_begin, '\n', (size_t)(text_end - line_begin));
+        if (line_end == NULL)
+            line_end = text_end;
+
+        // Get color spans from cache or from user callback
+        const ImGuiInputTextColorSpan* spans;
+        int spans_count;
+        if (state != NULL)
+            while (cache_n < state->ColorLines.Size && state->ColorLines[cache_n].Line < line_no)
+                cache_n++;
+        if (state != NULL && cache_n < state->ColorLines.Size && state->ColorLines[cache_n].Line == line_no)
+        {
+            spans = state->ColorSpans.Data + state->ColorLines[cache_n].SpansStart;
+            spans_count = state->ColorLines[cache_n].SpansCount;
+        }
+        else
+        {
+            g.InputTextColorSpans.resize(0);
+            ImGuiInputTextCallbackData callback_data;
+            callback_data.Ctx = &g;
+            callback_data.EventFlag = ImGuiInputTextFlags_CallbackColor;
+            callback_data.Flags = flags;
+            callback_data.UserData = user_data;
+            callback_data.EventLine = line_no;
+            callback_data.Buf = (char*)line_begin;
+            callback_data.BufTextLen = callback_data.BufSize = (int)(line_end - line_begin);
+            callback(&callback_data);
+            if (state != NULL && callback_data.ColorCacheDirty)
+                state->SetColorDirtyLines(0, INT_MAX); // Cached lines are dropped on next render, including this one
+            spans = g.InputTextColorSpans.Data;
+            spans_count = g.InputTextColorSpans.Size;
+            if (state != NULL)
+            {
+                ImGuiInputTextColorLine entry = { line_no, state->ColorSpans.Size, spans_count };
+                state->ColorSpans.resize(state->ColorSpans.Size + spans_count);
+                if (spans_count > 0)
+                    memcpy(state->ColorSpans.Data + entry.SpansStart, spans, (size_t)spans_count * sizeof(ImGuiInputTextColorSpan));
+                state->ColorLines.insert(state->ColorLines.Data + cache_n, entry);
+            }
+        }
+
+        // Render line, one segment for each span and for uncolored text between spans
+        ImVec2 segment_pos(pos.x, pos.y + line_no * line_height);
+        const char* s = line_begin;
+        for (int n = 0; n <= spans_count && s < line_end && segment_pos.x < clip_rect.z; n++)
+        {
+            const char* span_begin = (n < spans_count) ? ImClamp(line_begin + spans[n].Start, s, line_end) : line_end;
+            const char* span_end = (n < spans_count) ? ImClamp(line_begin + spans[n].End, span_begin, line_end) : line_end;
+            if (span_begin > s)
+            {
+                draw_list->AddText(g.Font, g.FontSize, segment_pos, col, s, span_begin);
+                segment_pos.x += g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, 0.0f, s, span_begin).x;
+            }
+            if (span_end > span_begin)
+            {
+                draw_list->AddText(g.Font, g.FontSize, segment_pos, spans[n].Col, span_begin, span_end);
+                segment_pos.x += g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, 0.0f, span_begin, span_end).x;
+            }
+            s = span_end;
+        }
+
+        if (line_end == text_end)
+            break;
+        line_begin = line_end + 1;
+    }
+}
+
 // Return false to discard a character.
 static bool InputTextFilterCharacter(ImGuiContext* ctx, unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data, bool input_source_is_clipboard)
 {
@@ -4022,12 +4538,11 @@ static bool InputTextFilterCharacter(ImGuiContext* ctx, unsigned int* p_char, Im
 }
 
 // Find the shortest single replacement we can make to get the new text from the old text.
-// Important: needs to be run before TextW is rewritten with the new characters because calling STB_TEXTEDIT_GETCHAR() at the end.
+// Important: needs to be run before TextW is rewritten with the new characters because calling STB_TEXTEDIT_GETCHAR().
 // FIXME: Ideally we should transition toward (1) making InsertChars()/DeleteChars() update undo-stack (2) discourage (and keep reconcile) or obsolete (and remove reconcile) accessing buffer directly.
 static void InputTextReconcileUndoStateAfterUserCallback(ImGuiInputTextState* state, const char* new_buf_a, int new_length_a)
 {
     ImGuiContext& g = *GImGui;
-    const ImWchar* old_buf = state->TextW.Data;
     const int old_length = state->CurLenW;
     const int new_length = ImTextCountCharsFromUtf8(new_buf_a, new_buf_a + new_length_a);
     g.TempBuffer.reserve_discard((new_length + 1) * sizeof(ImWchar));
@@ -4037,7 +4552,7 @@ static void InputTextReconcileUndoStateAfterUserCallback(ImGuiInputTextState* st
     const int shorter_length = ImMin(old_length, new_length);
     int first_diff;
     for (first_diff = 0; first_diff < shorter_length; first_diff++)
-        if (old_buf[first_diff] != new_buf[first_diff])
+        if (state->GetCharW(first_diff) != new_buf[first_diff])
             break;
     if (first_diff == old_length && first_diff == new_length)
         return;
@@ -4045,15 +4560,13 @@ static void InputTextReconcileUndoStateAfterUserCallback(ImGuiInputTextState* st
     int old_last_diff = old_length - 1;
     int new_last_diff = new_length - 1;
     for (; old_last_diff >= first_diff && new_last_diff >= first_diff; old_last_diff--, new_last_diff--)
-        if (old_buf[old_last_diff] != new_buf[new_last_diff])
+        if (state->GetCharW(old_last_diff) != new_buf[new_last_diff])
             break;
 
     const int insert_len = new_last_diff - first_diff + 1;
     const int delete_len = old_last_diff - first_diff + 1;
     if (insert_len > 0 || delete_len > 0)
-        if (IMSTB_TEXTEDIT_CHARTYPE* p = stb_text_createundo(&state->Stb.undostate, first_diff, delete_len, insert_len))
-            for (int i = 0; i < delete_len; i++)
-                p[i] = ImStb::STB_TEXTEDIT_GETCHAR(state, first_diff + i);
+        stb_text_makeundo_replace(state, &state->Stb, first_diff, delete_len, insert_len);
 }
 
 // As InputText() retain textual data and we currently provide a path for user to not retain it (via local variables)
@@ -4181,6 +4694,8 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     const bool is_resizable = (flags & ImGuiInputTextFlags_CallbackResize) != 0;
     if (is_resizable)
         IM_ASSERT(callback != NULL); // Must provide a callback if you set the ImGuiInputTextFlags_CallbackResize flag!
+    if (flags & ImGuiInputTextFlags_CallbackColor)
+        IM_ASSERT(callback != NULL); // Must provide a callback if you set the ImGuiInputTextFlags_CallbackColor flag!
 
     const bool input_requested_by_nav = (g.ActiveId != id) && ((g.NavActivateId == id) && ((g.NavActivateFlags & ImGuiActivateFlags_PreferInput) || (g.NavInputSource == ImGuiInputSource_Keyboard)));
 
@@ -4222,13 +4737,10 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             recycle_state = false;
 
         // Start edition
-        const char* buf_end = NULL;
         state->ID = id;
         state->TextW.resize(buf_size + 1);          // wchar count <= UTF-8 count. we use +1 to make sure that .Data is always pointing to at least an empty string.
-        state->TextA.resize(0);
-        state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
-        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
-        state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL);
+        InputTextResetTextAFromTextW(state, buf_size);
 
         if (recycle_state)
         {
@@ -4306,19 +4818,21 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     bool validated = false;
 
     // When read-only we always use the live data passed to the function
-    // FIXME-OPT: Because our selection/cursor code currently needs the wide text we need to convert it when active, which is not ideal :(
+    // Because our selection/cursor code needs the wide text we need to convert it when it changes, TextA holds a copy of the data to compare with (and display).
     if (is_readonly && state != NULL && (render_cursor || render_selection))
     {
-        const char* buf_end = NULL;
-        state->TextW.resize(buf_size + 1);
-        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
-        state->CurLenA = (int)(buf_end - buf);
-        state->CursorClamp();
+        if (strncmp(state->TextA.Data, buf, state->CurLenA + 1) != 0)
+        {
+            state->TextW.resize(buf_size + 1);
+            state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL);
+            InputTextResetTextAFromTextW(state, 0);
+            state->CursorClamp();
+        }
         render_selection &= state->HasSelection();
     }
 
     // Select the buffer to render.
-    const bool buf_display_from_state = (render_cursor || render_selection || g.ActiveId == id) && !is_readonly && state && state->TextAIsValid;
+    const bool buf_display_from_state = (render_cursor || render_selection || g.ActiveId == id) && state && state->TextAIsValid;
     const bool is_displaying_hint = (hint != NULL && (buf_display_from_state ? state->TextA.Data : buf)[0] == 0);
 
     // Password pushes a temporary font with only a fallback glyph
@@ -4333,7 +4847,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         password_font->ContainerAtlas = g.Font->ContainerAtlas;
         password_font->FallbackGlyph = glyph;
         password_font->FallbackAdvanceX = glyph->AdvanceX;
-        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty());
+        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexPages.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty());
         PushFont(password_font);
     }
 
@@ -4346,6 +4860,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->Edited = false;
         state->BufCapacityA = buf_size;
         state->Flags = flags;
+        state->Stb.undostate.undo_size_max = io.ConfigInputTextUndoMemory;
 
         // Although we are active we don't prevent mouse from hovering other elements unless we are interacting right now with the widget.
         // Down the line we should have a cleaner library-wide concept of Selected vs Active.
@@ -4569,9 +5084,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
-                const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
+                const int clipboard_data_len = InputTextCountUtf8BytesW(state, ib, ie) + 1;
                 char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
-                ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
+                InputTextStrToUtf8W(state, clipboard_data, clipboard_data_len, ib, ie);
                 SetClipboardText(clipboard_data);
                 MemFree(clipboard_data);
             }
@@ -4648,14 +5163,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             }
         }
 
-        // Apply ASCII value
-        if (!is_readonly)
-        {
-            state->TextAIsValid = true;
-            state->TextA.resize(state->TextW.Size * 4 + 1);
-            ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
-        }
-
         // When using 'ImGuiInputTextFlags_EnterReturnsTrue' as a special case we reapply the live buffer back to the input buffer
         // before clearing ActiveId, even though strictly speaking it wasn't modified on this frame.
         // If we didn't do that, code like InputInt() with ImGuiInputTextFlags_EnterReturnsTrue would fail.
@@ -4665,10 +5172,11 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         const bool apply_edit_back_to_user_buffer = !revert_edit || (validated && (flags & ImGuiInputTextFlags_EnterReturnsTrue) != 0);
         if (apply_edit_back_to_user_buffer)
         {
-            // Apply new value immediately - copy modified buffer back
-            // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
-            // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
+            // Apply new value - copy modified buffer back
+            // TextA is updated along with TextW by each edit (see STB_TEXTEDIT_INSERTCHARS/STB_TEXTEDIT_DELETECHARS), so there is no conversion here:
+            // it is only copied back to 'buf' on frames where it may have changed (see 'may_have_changed' below).
+            // As soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer:
+            // a change made to 'buf' while active isn't displayed, is overwritten by the next edit, and is only picked up when the widget is activated again.
 
             // User callback
             if ((flags & (ImGuiInputTextFlags_CallbackCompletion | ImGuiInputTextFlags_CallbackHistory | ImGuiInputTextFlags_CallbackEdit | ImGuiInputTextFlags_CallbackAlways)) != 0)
@@ -4710,6 +5218,8 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     callback_data.Flags = flags;
                     callback_data.UserData = callback_user_data;
 
+                    if (!is_readonly && state->TextA.Size < state->BufCapacityA)
+                        state->TextA.resize(state->BufCapacityA); // Callback may write up to BufSize
                     char* callback_buf = is_readonly ? buf : state->TextA.Data;
                     callback_data.EventKey = event_key;
                     callback_data.Buf = callback_buf;
@@ -4717,11 +5227,10 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     callback_data.BufSize = state->BufCapacityA;
                     callback_data.BufDirty = false;
 
-                    // We have to convert from wchar-positions to UTF-8-positions, which can be pretty slow (an incentive to ditch the ImWchar buffer, see https://github.com/nothings/stb/issues/188)
-                    ImWchar* text = state->TextW.Data;
-                    const int utf8_cursor_pos = callback_data.CursorPos = ImTextCountUtf8BytesFromStr(text, text + state->Stb.cursor);
-                    const int utf8_selection_start = callback_data.SelectionStart = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_start);
-                    const int utf8_selection_end = callback_data.SelectionEnd = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_end);
+                    // We have to convert from wchar-positions to UTF-8-positions, which we do relative to the gap position which is usually near the cursor.
+                    const int utf8_cursor_pos = callback_data.CursorPos = InputTextGetUtf8OffsetW(state, state->Stb.cursor);
+                    const int utf8_selection_start = callback_data.SelectionStart = InputTextGetUtf8OffsetW(state, state->Stb.select_start);
+                    const int utf8_selection_end = callback_data.SelectionEnd = InputTextGetUtf8OffsetW(state, state->Stb.select_end);
 
                     // Call user code
                     callback(&callback_data);
@@ -4731,6 +5240,8 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     IM_ASSERT(callback_data.Buf == callback_buf);         // Invalid to modify those fields
                     IM_ASSERT(callback_data.BufSize == state->BufCapacityA);
                     IM_ASSERT(callback_data.Flags == flags);
+                    if (callback_data.ColorCacheDirty)
+                        state->SetColorDirtyLines(0, INT_MAX);
                     const bool buf_dirty = callback_data.BufDirty;
                     if (callback_data.CursorPos != utf8_cursor_pos || buf_dirty)            { state->Stb.cursor = ImTextCountCharsFromUtf8(callback_data.Buf, callback_data.Buf + callback_data.CursorPos); state->CursorFollow = true; }
                     if (callback_data.SelectionStart != utf8_selection_start || buf_dirty)  { state->Stb.select_start = (callback_data.SelectionStart == callback_data.CursorPos) ? state->Stb.cursor : ImTextCountCharsFromUtf8(callback_data.Buf, callback_data.Buf + callback_data.SelectionStart); }
@@ -4742,15 +5253,19 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                         InputTextReconcileUndoStateAfterUserCallback(state, callback_data.Buf, callback_data.BufTextLen); // FIXME: Move the rest of this block inside function and rename to InputTextReconcileStateAfterUserCallback() ?
                         if (callback_data.BufTextLen > backup_current_text_length && is_resizable)
                             state->TextW.resize(state->TextW.Size + (callback_data.BufTextLen - backup_current_text_length)); // Worse case scenario resize
-                        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
-                        state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, callback_data.Buf + callback_data.BufTextLen);
+                        InputTextResetTextAFromTextW(state, state->TextA.Size);
                         state->CursorAnimReset();
+                        state->Edited = true;
                     }
                 }
             }
 
             // Will copy result string if modified
-            if (!is_readonly && strcmp(state->TextA.Data, buf) != 0)
+            // Only compare on frames where our text may have changed, so an active widget doesn't scan its text when idle. This is also why we don't
+            // reapply our text over 'buf' being modified while active (unless validating with ImGuiInputTextFlags_EnterReturnsTrue, see above).
+            const bool may_have_changed = state->Edited || (validated && (flags & ImGuiInputTextFlags_EnterReturnsTrue) != 0);
+            if (!is_readonly && may_have_changed && strcmp(state->TextA.Data, buf) != 0)
             {
                 apply_new_text = state->TextA.Data;
                 apply_new_text_length = state->CurLenA;
@@ -4846,57 +5361,28 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // - Measure text height (for scrollbar)
         // We are attempting to do most of that in **one main pass** to minimize the computation cost (non-negligible for large amount of text) + 2nd pass for selection rendering (we could merge them by an extra refactoring effort)
         // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
-        const ImWchar* text_begin = state->TextW.Data;
         ImVec2 cursor_offset, select_start_offset;
 
+        int select_start_line = 0;
         {
-            // Find lines numbers straddling 'cursor' (slot 0) and 'select_start' (slot 1) positions.
-            const ImWchar* searches_input_ptr[2] = { NULL, NULL };
-            int searches_result_line_no[2] = { -1000, -1000 };
-            int searches_remaining = 0;
-            if (render_cursor)
-            {
-                searches_input_ptr[0] = text_begin + state->Stb.cursor;
-                searches_result_line_no[0] = -1;
-                searches_remaining++;
-            }
-            if (render_selection)
+            // Find lines straddling 'cursor' (slot 0) and 'select_start' (slot 1) positions using the line index,
+            // then calculate 2d position by measuring distance from the beginning of the line.
+            for (int n = 0; n < 2; n++)
             {
-                searches_input_ptr[1] = text_begin + ImMin(state->Stb.select_start, state->Stb.select_end);
-                searches_result_line_no[1] = -1;
-                searches_remaining++;
-            }
-
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_no[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_no[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_no[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_no[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_no[0] == -1)
-                searches_result_line_no[0] = line_count;
-            if (searches_result_line_no[1] == -1)
-                searches_result_line_no[1] = line_count;
-
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(&g, ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_no[0] * g.FontSize;
-            if (searches_result_line_no[1] >= 0)
-            {
-                select_start_offset.x = InputTextCalcTextSizeW(&g, ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_no[1] * g.FontSize;
+                if ((n == 0 && !render_cursor) || (n == 1 && !render_selection))
+                    continue;
+                const int idx = (n == 0) ? state->Stb.cursor : ImMin(state->Stb.select_start, state->Stb.select_end);
+                const int line_no = state->GetLineFromIdxW(idx);
+                if (n == 1)
+                    select_start_line = line_no;
+                ImVec2& offset = (n == 0) ? cursor_offset : select_start_offset;
+                offset.x = InputTextCalcLineWidthW(state, state->GetLineStartW(line_no), idx);
+                offset.y = (line_no + 1) * g.FontSize;
             }
 
             // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
             if (is_multiline)
-                text_size = ImVec2(inner_size.x, line_count * g.FontSize);
+                text_size = ImVec2(inner_size.x, state->GetLineCount() * g.FontSize);
         }
 
         // Scroll
@@ -4938,28 +5424,38 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         const ImVec2 draw_scroll = ImVec2(state->ScrollX, 0.0f);
         if (render_selection)
         {
-            const ImWchar* text_selected_begin = text_begin + ImMin(state->Stb.select_start, state->Stb.select_end);
-            const ImWchar* text_selected_end = text_begin + ImMax(state->Stb.select_start, state->Stb.select_end);
+            int text_selected_begin = ImMin(state->Stb.select_start, state->Stb.select_end);
+            const int text_selected_end = ImMax(state->Stb.select_start, state->Stb.select_end);
 
             ImU32 bg_color = GetColorU32(ImGuiCol_TextSelectedBg, render_cursor ? 1.0f : 0.6f); // FIXME: current code flow mandate that render_cursor is always true here, we are leaving the transparent one for tests.
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            if (rect_pos.y < clip_rect.y && is_multiline)
+            {
+                // Skip lines above clipping rectangle using the line index
+                const int skip_lines = (int)((clip_rect.y - rect_pos.y) / g.FontSize);
+                const int line_no = ImMin(select_start_line + skip_lines, state->GetLineCount() - 1);
+                if (line_no > select_start_line)
+                {
+                    rect_pos.x = draw_pos.x - draw_scroll.x;
+                    rect_pos.y += (line_no - select_start_line) * g.FontSize;
+                    text_selected_begin = ImMin(state->GetLineStartW(line_no), text_selected_end);
+                }
+            }
+            for (int p = text_selected_begin; p < text_selected_end; )
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
                 if (rect_pos.y < clip_rect.y)
                 {
-                    //p = (const ImWchar*)wmemchr((const wchar_t*)p, '\n', text_selected_end - p);  // FIXME-OPT: Could use this when wchar_t are 16-bit
-                    //p = p ? p + 1 : text_selected_end;
                     while (p < text_selected_end)
-                        if (*p++ == '\n')
+                        if (state->GetCharW(p++) == '\n')
                             break;
                 }
                 else
                 {
-                    ImVec2 rect_size = InputTextCalcTextSizeW(&g, p, text_selected_end, &p, NULL, true);
+                    ImVec2 rect_size(InputTextCalcLineWidthW(state, p, text_selected_end, &p), g.FontSize);
                     if (rect_size.x <= 0.0f) rect_size.x = IM_TRUNC(g.Font->GetCharAdvance((ImWchar)' ') * 0.50f); // So we can see selected empty lines
                     ImRect rect(rect_pos + ImVec2(0.0f, bg_offy_up - g.FontSize), rect_pos + ImVec2(rect_size.x, bg_offy_dn));
                     rect.ClipWith(clip_rect);
@@ -4974,8 +5470,25 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
         if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
+            // Only submit visible lines, using the line index
+            ImVec2 text_pos = draw_pos - draw_scroll;
+            const char* text_begin = buf_display;
+            const char* text_end = buf_display_end;
+            if (is_multiline && !is_displaying_hint && buf_display_from_state)
+            {
+                const int line_count = state->GetLineCount();
+                const int line_min = ImClamp((int)((clip_rect.y - text_pos.y) / g.FontSize) - 1, 0, line_count - 1);
+                const int line_max = ImClamp((int)((clip_rect.w - text_pos.y) / g.FontSize) + 1, line_min, line_count - 1);
+                text_pos.y += line_min * g.FontSize;
+                text_begin = buf_display + state->GetLineStartA(line_min);
+                if (line_max + 1 < line_count)
+                    text_end = buf_display + state->GetLineStartA(line_max + 1);
+            }
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
-            draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
+            if (is_multiline && !is_displaying_hint && (flags & ImGuiInputTextFlags_CallbackColor))
+                InputTextRenderColoredLines(&g, buf_display_from_state ? state : NULL, draw_window->DrawList, draw_pos - draw_scroll, clip_rect, col, buf_display, buf_display_end, flags, callback, callback_user_data);
+            else
+                draw_window->DrawList->AddText(g.Font, g.FontSize, text_pos, col, text_begin, text_end, 0.0f, is_multiline ? NULL : &clip_rect);
         }
 
         // Draw blinking cursor
@@ -5010,7 +5523,10 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
-            draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
+            if (is_multiline && !is_displaying_hint && (flags & ImGuiInputTextFlags_CallbackColor))
+                InputTextRenderColoredLines(&g, buf_display_from_state ? state : NULL, draw_window->DrawList, draw_pos, clip_rect, col, buf_display, buf_display_end, flags, callback, callback_user_data);
+            else
+                draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
         }
     }
 
@@ -5065,25 +5581,30 @@ void ImGui::DebugNodeInputTextState(ImGuiInputTextState* state)
     Text("ID: 0x%08X, ActiveID: 0x%08X", state->ID, g.ActiveId);
     DebugLocateItemOnHover(state->ID);
     Text("CurLenW: %d, CurLenA: %d, Cursor: %d, Selection: %d..%d", state->CurLenW, state->CurLenA, stb_state->cursor, stb_state->select_start, stb_state->select_end);
+    Text("TextW.Size: %d, Gap: %d..%d, GapPosA: %d, Lines: %d (%d before gap)", state->TextW.Size, state->GapPosW, state->GapPosW + state->GetGapLenW(), state->GapPosA, state->GetLineCount(), state->NewlinesBeforeGap.Size);
     Text("has_preferred_x: %d (%.2f)", stb_state->has_preferred_x, stb_state->preferred_x);
     Text("undo_point: %d, redo_point: %d, undo_char_point: %d, redo_char_point: %d", undo_state->undo_point, undo_state->redo_point, undo_state->undo_char_point, undo_state->redo_char_point);
+    Text("undo storage: %d records, %d bytes of characters (%d/%d bytes)", undo_state->undo_rec_count, undo_state->undo_char_count, state->GetUndoMemoryUsage(), undo_state->undo_size_max);
     if (BeginChild("undopoints", ImVec2(0.0f, GetTextLineHeight() * 10), ImGuiChildFlags_Border | ImGuiChildFlags_ResizeY)) // Visualize undo state
     {
         PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
-        for (int n = 0; n < IMSTB_TEXTEDIT_UNDOSTATECOUNT; n++)
-        {
-            ImStb::StbUndoRecord* undo_rec = &undo_state->undo_rec[n];
-            const char undo_rec_type = (n < undo_state->undo_point) ? 'u' : (n >= undo_state->redo_point) ? 'r' : ' ';
-            if (undo_rec_type == ' ')
-                BeginDisabled();
-            char buf[64] = "";
-            if (undo_rec_type != ' ' && undo_rec->char_storage != -1)
-                ImTextStrToUtf8(buf, IM_ARRAYSIZE(buf), undo_state->undo_char + undo_rec->char_storage, undo_state->undo_char + undo_rec->char_storage + undo_rec->insert_length);
-            Text("%c [%02d] where %03d, insert %03d, delete %03d, char_storage %03d \"%s\"",
-                undo_rec_type, n, undo_rec->where, undo_rec->insert_length, undo_rec->delete_length, undo_rec->char_storage, buf);
-            if (undo_rec_type == ' ')
-                EndDisabled();
-        }
+        ImGuiListClipper clipper;
+        clipper.Begin(undo_state->undo_rec_count);
+        while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            {
+                ImStb::StbUndoRecord* undo_rec = &undo_state->undo_rec[n];
+                const char undo_rec_type = (n < undo_state->undo_point) ? 'u' : (n >= undo_state->redo_point) ? 'r' : ' ';
+                if (undo_rec_type == ' ')
+                    BeginDisabled();
+                int char_storage_size = 0;
+                if (undo_rec_type != ' ' && undo_rec->char_storage != -1)
+                    char_storage_size = ImStb::stb_text_undo_storage_size(undo_state->undo_char + undo_rec->char_storage, undo_rec->insert_length);
+                Text("%c [%02d] where %03d, insert %03d, delete %03d, char_storage %03d \"%.*s\"",
+                    undo_rec_type, n, undo_rec->where, undo_rec->insert_length, undo_rec->delete_length, undo_rec->char_storage, ImMin(char_storage_size, 64), char_storage_size ? undo_state->undo_char + undo_rec->char_storage : "");
+                if (undo_rec_type == ' ')
+                    EndDisabled();
+            }
         PopStyleVar();
     }
     EndChild();
@@ -6028,6 +6549,7 @@ void ImGui::ColorPickerOptionsPopup(const float* ref_col, ImGuiColorEditFlags fl
 // - GetTreeNodeToLabelSpacing()
 // - SetNextItemOpen()
 // - CollapsingHeader()
+// - ImGuiTreeClipper
 //-------------------------------------------------------------------------
 
 bool ImGui::TreeNode(const char* str_id, const char* fmt, ...)
@@ -6511,6 +7033,224 @@ bool ImGui::CollapsingHeader(const char* label, bool* p_visible, ImGuiTreeNodeFl
     return is_open;
 }
 
+ImGuiTreeClipper::ImGuiTreeClipper()
+{
+    TempData = NULL;
+}
+
+ImGuiTreeClipper::~ImGuiTreeClipper()
+{
+    if (ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData)
+        IM_DELETE(data);
+}
+
+// Append rows for the descendants of 'node' whose ancestors are all open, in depth-first order.
+// 'row' is the row of 'node' (-1 for the root): appended rows are numbered as if 'out_rows' was going to be inserted right after it.
+static void ImGuiTreeClipper_BuildRows(ImGuiTreeClipperData* data, void* node, int row, int depth, ImVector<ImGuiTreeClipperRow>& out_rows)
+{
+    const int default_open = (data->Flags & ImGuiTreeNodeFlags_DefaultOpen) ? 1 : 0;
+    ImGuiTreeClipperBuildLevel root_level = { node, row, 0, data->GetChildrenCount(data->UserData, node) };
+    data->BuildStack.resize(0);
+    data->BuildStack.push_back(root_level);
+    while (data->BuildStack.Size > 0)
+    {
+        ImGuiTreeClipperBuildLevel* level = &data->BuildStack.back();
+        if (level->ChildN >= level->ChildrenCount)
+        {
+            data->BuildStack.pop_back();
+            continue;
+        }
+        ImGuiTreeClipperRow child_row;
+        child_row.Node = data->GetChild(data->UserData, level->Node, level->ChildN++);
+        child_row.ParentRow = level->Row;
+        child_row.Depth = depth + data->BuildStack.Size - 1;
+        const int children_count = data->GetChildrenCount(data->UserData, child_row.Node);
+        child_row.HasChildren = (children_count > 0);
+        child_row.IsOpen = child_row.HasChildren && data->Storage->GetInt(data->GetNodeID(child_row.Node), default_open) != 0;
+        out_rows.push_back(child_row);
+        if (child_row.IsOpen)
+        {
+            ImGuiTreeClipperBuildLevel child_level = { child_row.Node, row + out_rows.Size, 0, children_count };
+            data->BuildStack.push_back(child_level);
+        }
+    }
+}
+
+// Open or close a row: insert or remove the rows of its subtree, and fix indices referring to the following rows.
+static void ImGuiTreeClipper_ToggleRow(ImGuiTreeClipperData* data, int row_n)
+{
+    ImVector<ImGuiTreeClipperRow>& rows = data->Rows;
+    const int depth = rows[row_n].Depth;
+    int subtree_end = row_n + 1;
+    int shift;
+    if (!rows[row_n].IsOpen)
+    {
+        rows[row_n].IsOpen = true;
+        data->BuildRows.resize(0);
+        ImGuiTreeClipper_BuildRows(data, rows[row_n].Node, row_n, depth + 1, data->BuildRows);
+        shift = data->BuildRows.Size;
+        const int old_size = rows.Size;
+        rows.resize(old_size + shift);
+        memmove(rows.Data + subtree_end + shift, rows.Data + subtree_end, (size_t)(old_size - subtree_end) * sizeof(ImGuiTreeClipperRow));
+        memcpy(rows.Data + subtree_end, data->BuildRows.Data, (size_t)shift * sizeof(ImGuiTreeClipperRow));
+        subtree_end += shift;
+    }
+    else
+    {
+        rows[row_n].IsOpen = false;
+        while (subtree_end < rows.Size && rows[subtree_end].Depth > depth)
+            subtree_end++;
+        shift = -(subtree_end - (row_n + 1));
+        if (data->NavRow > row_n && data->NavRow < subtree_end)
+            data->NavRow = -1;
+        rows.erase(rows.Data + row_n + 1, rows.Data + subtree_end);
+        subtree_end = row_n + 1;
+    }
+    for (int n = subtree_end; n < rows.Size; n++)
+        if (rows[n].ParentRow > row_n)
+            rows[n].ParentRow += shift;
+    if (data->NavRow > row_n)
+        data->NavRow += shift;
+}
+
+void ImGuiTreeClipper::Begin(ImGuiListClipper* clipper, int (*get_children_count)(void* user_data, void* node), void* (*get_child)(void* user_data, void* node, int child_n), void* user_data, ImGuiTreeNodeFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    IM_ASSERT((flags & ImGuiTreeNodeFlags_NoTreePushOnOpen) == 0 && "ImGuiTreeClipper needs to push open nodes to handle depth and navigation.");
+    if (TempData == NULL)
+        TempData = IM_NEW(ImGuiTreeClipperData)();
+    ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData;
+    IM_ASSERT(!data->IsActive && "Missing call to ImGuiTreeClipper::End()?");
+
+    // Rebuild all rows if requested, or if nodes IDs or open states storage changed (e.g. used from another window)
+    if (data->SeedID != window->IDStack.back() || data->Storage != window->DC.StateStorage || data->Flags != flags)
+        data->IsDirty = true;
+    data->GetChildrenCount = get_children_count;
+    data->GetChild = get_child;
+    data->UserData = user_data;
+    data->Flags = flags;
+    data->SeedID = window->IDStack.back();
+    data->Storage = window->DC.StateStorage;
+    if (data->IsDirty)
+    {
+        data->Rows.resize(0);
+        ImGuiTreeClipper_BuildRows(data, NULL, -1, 0, data->Rows);
+        data->NavRow = -1;
+        data->IsDirty = false;
+    }
+    data->PushedRows.resize(0);
+    data->ToggledRows.resize(0);
+    data->IsActive = true;
+
+    // Always submit the parent of the focused row, so ImGuiTreeNodeFlags_NavLeftJumpsBackHere can land on it
+    // (it needs to be submitted before the focused row, and popped after it).
+    clipper->Begin(data->Rows.Size);
+    if (data->NavRow >= 0 && data->NavRow < data->Rows.Size && data->Rows[data->NavRow].ParentRow != -1)
+        clipper->IncludeItemByIndex(data->Rows[data->NavRow].ParentRow);
+}
+
+void ImGuiTreeClipper::End()
+{
+    ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData;
+    IM_ASSERT(data != NULL && data->IsActive && "Missing call to ImGuiTreeClipper::Begin()?");
+
+    // Pop remaining ancestors (this is where a NavLeftJumpsBackHere request may be resolved)
+    for (int n = data->PushedRows.Size; n > 0; n--)
+        ImGui::TreePop();
+    data->PushedRows.resize(0);
+
+    // Open/close toggled rows. Rows are submitted in increasing order: process the last one first so others indices stay valid.
+    for (int n = data->ToggledRows.Size - 1; n >= 0; n--)
+        ImGuiTreeClipper_ToggleRow(data, data->ToggledRows[n]);
+    data->ToggledRows.resize(0);
+    data->IsActive = false;
+}
+
+bool ImGuiTreeClipper::TreeNode(int row_n, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    bool is_open = TreeNodeV(row_n, fmt, args);
+    va_end(args);
+    return is_open;
+}
+
+bool ImGuiTreeClipper::TreeNodeV(int row_n, const char* fmt, va_list args)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData;
+    IM_ASSERT(data != NULL && data->IsActive && "Missing call to ImGuiTreeClipper::Begin()?");
+    IM_ASSERT(row_n >= 0 && row_n < data->Rows.Size);
+    if (window->SkipItems)
+        return false;
+
+    // Make tree depth and ID stack hold the ancestors of this row, as if they had been submitted with TreeNode():
+    // find the deepest ancestor which is already pushed, pop rows pushed after it, then push the missing ancestors.
+    const ImGuiTreeClipperRow row = data->Rows[row_n];
+    int ancestor_row = row.ParentRow;
+    int ancestor_depth = row.Depth - 1;
+    data->TempRows.resize(0);
+    while (ancestor_row != -1 && !(ancestor_depth < data->PushedRows.Size && data->PushedRows[ancestor_depth] == ancestor_row))
+    {
+        data->TempRows.push_back(ancestor_row);
+        ancestor_row = data->Rows[ancestor_row].ParentRow;
+        ancestor_depth--;
+    }
+    for (int n = data->PushedRows.Size; n > ancestor_depth + 1; n--)
+        ImGui::TreePop();
+    data->PushedRows.resize(ancestor_depth + 1);
+    for (int n = data->TempRows.Size - 1; n >= 0; n--)
+    {
+        ImGui::TreePushOverrideID(data->GetNodeID(data->Rows[data->TempRows[n]].Node));
+        data->PushedRows.push_back(data->TempRows[n]);
+    }
+
+    ImGuiTreeNodeFlags flags = data->Flags;
+    if (!row.HasChildren)
+        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    const ImGuiID id = data->GetNodeID(row.Node);
+    const char* label, *label_end;
+    ImFormatStringToTempBufferV(&label, &label_end, fmt, args);
+    const bool is_open = ImGui::TreeNodeBehavior(id, flags, label, label_end);
+    if (id == g.NavId)
+        data->NavRow = row_n;
+    if (!row.HasChildren)
+        return false;
+    if (is_open)
+        data->PushedRows.push_back(row_n);
+    if (is_open != row.IsOpen && !g.LogEnabled)
+        data->ToggledRows.push_back(row_n);
+    return is_open;
+}
+
+void ImGuiTreeClipper::SetDirty()
+{
+    if (ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData)
+        data->IsDirty = true;
+}
+
+void* ImGuiTreeClipper::GetRowNode(int row_n) const
+{
+    ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData;
+    IM_ASSERT(data != NULL && row_n >= 0 && row_n < data->Rows.Size);
+    return data->Rows[row_n].Node;
+}
+
+int ImGuiTreeClipper::GetRowDepth(int row_n) const
+{
+    ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData;
+    IM_ASSERT(data != NULL && row_n >= 0 && row_n < data->Rows.Size);
+    return data->Rows[row_n].Depth;
+}
+
+int ImGuiTreeClipper::GetRowsCount() const
+{
+    ImGuiTreeClipperData* data = (ImGuiTreeClipperData*)TempData;
+    return data ? data->Rows.Size : 0;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Selectable
 //-------------------------------------------------------------------------
@@ -6976,6 +7716,8 @@ bool ImGui::ListBox(const char* label, int* current_item, const char* (*getter)(
     bool value_changed = false;
     ImGuiListClipper clipper;
     clipper.Begin(items_count, GetTextLineHeightWithSpacing()); // We know exactly our line height here so we pass it as a minor optimization, but generally you don't need to.
+    if (*current_item >= 0 && *current_item < items_count)
+        clipper.IncludeItemByIndex(*current_item);              // Keep current item submitted so SetItemDefaultFocus() can apply when navigating into the list box
     while (clipper.Step())
         for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
         {
@@ -7015,6 +7757,95 @@ bool ImGui::ListBox(const char* label, int* current_item, const char* (*getter)(
 // - others https://github.com/ocornut/imgui/wiki/Useful-Extensions
 //-------------------------------------------------------------------------
 
+struct ImGuiPlotArrayGetterData
+{
+    const float* Values;
+    int Stride;
+
+    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
+};
+
+static float Plot_ArrayGetter(void* data, int idx)
+{
+    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
+    const float v = *(const float*)(const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
+    return v;
+}
+
+// Update min/max with 'count' contiguous values, ignoring NaN values.
+static void Plot_CalcMinMax(const float* values, int count, float* p_min, float* p_max)
+{
+    float v_min = *p_min;
+    float v_max = *p_max;
+#ifdef IMGUI_ENABLE_SSE
+    if (count >= 8)
+    {
+        // _mm_min_ps()/_mm_max_ps() return their second operand if either is NaN: passing values first ignores NaN values.
+        __m128 min0 = _mm_set1_ps(v_min), min1 = min0;
+        __m128 max0 = _mm_set1_ps(v_max), max1 = max0;
+        for (; count >= 8; count -= 8, values += 8)
+        {
+            const __m128 a = _mm_loadu_ps(values);
+            const __m128 b = _mm_loadu_ps(values + 4);
+            min0 = _mm_min_ps(a, min0);
+            min1 = _mm_min_ps(b, min1);
+            max0 = _mm_max_ps(a, max0);
+            max1 = _mm_max_ps(b, max1);
+        }
+        min0 = _mm_min_ps(min0, min1);
+        max0 = _mm_max_ps(max0, max1);
+        min0 = _mm_min_ps(min0, _mm_movehl_ps(min0, min0));
+        max0 = _mm_max_ps(max0, _mm_movehl_ps(max0, max0));
+        min0 = _mm_min_ss(min0, _mm_shuffle_ps(min0, min0, _MM_SHUFFLE(1, 1, 1, 1)));
+        max0 = _mm_max_ss(max0, _mm_shuffle_ps(max0, max0, _MM_SHUFFLE(1, 1, 1, 1)));
+        v_min = _mm_cvtss_f32(min0);
+        v_max = _mm_cvtss_f32(max0);
+    }
+#endif
+    for (; count > 0; count--, values++)
+    {
+        const float v = *values;
+        if (v != v) // Ignore NaN values
+            continue;
+        v_min = ImMin(v_min, v);
+        v_max = ImMax(v_max, v);
+    }
+    *p_min = v_min;
+    *p_max = v_max;
+}
+
+// Summarize values [idx_begin, idx_end) of a plot, before applying 'values_offset'.
+// Arrays of contiguous floats submitted with PlotLines()/PlotHistogram() are read directly instead of going through the getter.
+static void Plot_CalcColumn(float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, int idx_begin, int idx_end, ImGuiPlotColumn* out_column)
+{
+    const ImGuiPlotArrayGetterData* array = (values_getter == &Plot_ArrayGetter) ? (const ImGuiPlotArrayGetterData*)data : NULL;
+    out_column->Min = FLT_MAX;
+    out_column->Max = -FLT_MAX;
+    out_column->First = values_getter(data, (idx_begin + values_offset) % values_count);
+    out_column->Last = values_getter(data, (idx_end - 1 + values_offset) % values_count);
+    int idx = (idx_begin + values_offset) % values_count;
+    for (int remaining = idx_end - idx_begin; remaining > 0; idx = 0) // Up to two contiguous spans with 'values_offset' wrapping around
+    {
+        const int span = ImMin(remaining, values_count - idx);
+        if (array != NULL && array->Stride == (int)sizeof(float))
+        {
+            Plot_CalcMinMax(array->Values + idx, span, &out_column->Min, &out_column->Max);
+        }
+        else
+        {
+            for (int i = idx; i < idx + span; i++)
+            {
+                const float v = array ? Plot_ArrayGetter(data, i) : values_getter(data, i);
+                if (v != v) // Ignore NaN values
+                    continue;
+                out_column->Min = ImMin(out_column->Min, v);
+                out_column->Max = ImMax(out_column->Max, v);
+            }
+        }
+        remaining -= span;
+    }
+}
+
 int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, const ImVec2& size_arg)
 {
     ImGuiContext& g = *GImGui;
@@ -7036,32 +7867,48 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
         return -1;
     const bool hovered = ItemHoverable(frame_bb, id, g.LastItemData.InFlags);
 
+    // When there are more values than pixels, summarize the values covered by each pixel column so peaks are not lost.
+    // The scale is derived from those columns, so each value is only read once.
+    const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
+    const int columns_count = ImMax((int)inner_bb.GetWidth(), 1);
+    const bool decimate = (values_count >= values_count_min && values_count > (int)frame_size.x);
+    ImVector<ImGuiPlotColumn>& columns = g.PlotColumns;
+    if (decimate)
+    {
+        columns.resize(columns_count);
+        for (int n = 0; n < columns_count; n++)
+            Plot_CalcColumn(values_getter, data, values_count, values_offset, (int)((ImS64)n * values_count / columns_count), (int)((ImS64)(n + 1) * values_count / columns_count), &columns[n]);
+    }
+
     // Determine scale from values if not specified
     if (scale_min == FLT_MAX || scale_max == FLT_MAX)
     {
-        float v_min = FLT_MAX;
-        float v_max = -FLT_MAX;
-        for (int i = 0; i < values_count; i++)
+        ImGuiPlotColumn values_range;
+        values_range.Min = FLT_MAX;
+        values_range.Max = -FLT_MAX;
+        if (decimate)
         {
-            const float v = values_getter(data, i);
-            if (v != v) // Ignore NaN values
-                continue;
-            v_min = ImMin(v_min, v);
-            v_max = ImMax(v_max, v);
+            for (const ImGuiPlotColumn& column : columns)
+            {
+                values_range.Min = ImMin(values_range.Min, column.Min);
+                values_range.Max = ImMax(values_range.Max, column.Max);
+            }
+        }
+        else if (values_count > 0)
+        {
+            Plot_CalcColumn(values_getter, data, values_count, 0, 0, values_count, &values_range);
         }
         if (scale_min == FLT_MAX)
-            scale_min = v_min;
+            scale_min = values_range.Min;
         if (scale_max == FLT_MAX)
-            scale_max = v_max;
+            scale_max = values_range.Max;
     }
 
     RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
 
-    const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
     int idx_hovered = -1;
     if (values_count >= values_count_min)
     {
-        int res_w = ImMin((int)frame_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
         int item_count = values_count + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
 
         // Tooltip on hover
@@ -7080,41 +7927,84 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
             idx_hovered = v_idx;
         }
 
-        const float t_step = 1.0f / (float)res_w;
         const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
-
-        float v0 = values_getter(data, (0 + values_offset) % values_count);
-        float t0 = 0.0f;
-        ImVec2 tp0 = ImVec2( t0, 1.0f - ImSaturate((v0 - scale_min) * inv_scale) );                       // Point in the normalized space of our target rectangle
         float histogram_zero_line_t = (scale_min * scale_max < 0.0f) ? (1 + scale_min * inv_scale) : (scale_min < 0.0f ? 0.0f : 1.0f);   // Where does the zero line stands
 
         const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
         const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
 
-        for (int n = 0; n < res_w; n++)
+        if (decimate)
         {
-            const float t1 = t0 + t_step;
-            const int v1_idx = (int)(t0 * item_count + 0.5f);
-            IM_ASSERT(v1_idx >= 0 && v1_idx < values_count);
-            const float v1 = values_getter(data, (v1_idx + values_offset + 1) % values_count);
-            const ImVec2 tp1 = ImVec2( t1, 1.0f - ImSaturate((v1 - scale_min) * inv_scale) );
-
-            // NB: Draw calls are merged together by the DrawList system. Still, we should render our batch are lower level to save a bit of CPU.
-            ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
-            ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, (plot_type == ImGuiPlotType_Lines) ? tp1 : ImVec2(tp1.x, histogram_zero_line_t));
-            if (plot_type == ImGuiPlotType_Lines)
+            // Draw one vertical line or bar per pixel column, spanning all its values. Lines are connected to the previous column.
+            const float histogram_zero_line_y = ImLerp(inner_bb.Min.y, inner_bb.Max.y, histogram_zero_line_t);
+            ImVec2 prev_pos;
+            bool prev_valid = false;
+            for (int n = 0; n < columns_count; n++)
             {
-                window->DrawList->AddLine(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                const ImGuiPlotColumn& column = columns[n];
+                if (column.Min > column.Max) // All NaN
+                {
+                    prev_valid = false;
+                    continue;
+                }
+                const int idx_begin = (int)((ImS64)n * values_count / columns_count);
+                const int idx_end = (int)((ImS64)(n + 1) * values_count / columns_count);
+                const ImU32 col = (idx_hovered >= idx_begin && idx_hovered < idx_end) ? col_hovered : col_base;
+                const float x0 = ImLerp(inner_bb.Min.x, inner_bb.Max.x, (float)n / (float)columns_count);
+                const float x1 = ImLerp(inner_bb.Min.x, inner_bb.Max.x, (float)(n + 1) / (float)columns_count);
+                const float y_min = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((column.Min - scale_min) * inv_scale));
+                const float y_max = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((column.Max - scale_min) * inv_scale));
+                if (plot_type == ImGuiPlotType_Lines)
+                {
+                    const float x = (x0 + x1) * 0.5f;
+                    const float v_first = (column.First != column.First) ? column.Min : column.First;
+                    const float v_last = (column.Last != column.Last) ? column.Max : column.Last;
+                    if (prev_valid)
+                        window->DrawList->AddLine(prev_pos, ImVec2(x, ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_first - scale_min) * inv_scale))), col);
+                    if (y_max != y_min)
+                        window->DrawList->AddLine(ImVec2(x, y_max), ImVec2(x, y_min), col);
+                    prev_pos = ImVec2(x, ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_last - scale_min) * inv_scale)));
+                    prev_valid = true;
+                }
+                else if (plot_type == ImGuiPlotType_Histogram)
+                {
+                    window->DrawList->AddRectFilled(ImVec2(x0, ImMin(y_max, histogram_zero_line_y)), ImVec2(x1, ImMax(y_min, histogram_zero_line_y)), col);
+                }
             }
-            else if (plot_type == ImGuiPlotType_Histogram)
+        }
+        else
+        {
+            const int res_w = ImMin((int)frame_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
+            const float t_step = 1.0f / (float)res_w;
+            float v0 = values_getter(data, (0 + values_offset) % values_count);
+            float t0 = 0.0f;
+            ImVec2 tp0 = ImVec2( t0, 1.0f - ImSaturate((v0 - scale_min) * inv_scale) );                       // Point in the normalized space of our target rectangle
+
+            for (int n = 0; n < res_w; n++)
             {
-                if (pos1.x >= pos0.x + 2.0f)
-                    pos1.x -= 1.0f;
-                window->DrawList->AddRectFilled(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
-            }
+                const float t1 = t0 + t_step;
+                const int v1_idx = (int)(t0 * item_count + 0.5f);
+                IM_ASSERT(v1_idx >= 0 && v1_idx < values_count);
+                const float v1 = values_getter(data, (v1_idx + values_offset + 1) % values_count);
+                const ImVec2 tp1 = ImVec2( t1, 1.0f - ImSaturate((v1 - scale_min) * inv_scale) );
+
+                // NB: Draw calls are merged together by the DrawList system. Still, we should render our batch are lower level to save a bit of CPU.
+                ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
+                ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, (plot_type == ImGuiPlotType_Lines) ? tp1 : ImVec2(tp1.x, histogram_zero_line_t));
+                if (plot_type == ImGuiPlotType_Lines)
+                {
+                    window->DrawList->AddLine(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                }
+                else if (plot_type == ImGuiPlotType_Histogram)
+                {
+                    if (pos1.x >= pos0.x + 2.0f)
+                        pos1.x -= 1.0f;
+                    window->DrawList->AddRectFilled(pos0, pos1, idx_hovered == v1_idx ? col_hovered : col_base);
+                }
 
-            t0 = t1;
-            tp0 = tp1;
+                t0 = t1;
+                tp0 = tp1;
+            }
         }
     }
 
@@ -7130,21 +8020,6 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
     return idx_hovered;
 }
 
-struct ImGuiPlotArrayGetterData
-{
-    const float* Values;
-    int Stride;
-
-    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
-};
-
-static float Plot_ArrayGetter(void* data, int idx)
-{
-    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
-    const float v = *(const float*)(const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
-    return v;
-}
-
 void ImGui::PlotLines(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride)
 {
     ImGuiPlotArrayGetterData data(values, stride);
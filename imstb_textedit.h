@@ -3,6 +3,7 @@
 // Those changes would need to be pushed into nothings/stb:
 // - Fix in stb_textedit_discard_redo (see https://github.com/nothings/stb/issues/321)
 // - Fix in stb_textedit_find_charpos to handle last line (see https://github.com/ocornut/imgui/issues/6000 + #6783)
+// - Optional IMSTB_TEXTEDIT_SEEKROW_Y/IMSTB_TEXTEDIT_SEEKROW_CHAR to skip laying out all rows from the start of a large text
 // Grep for [DEAR IMGUI] to find the changes.
 // - Also renamed macros used or defined outside of IMSTB_TEXTEDIT_IMPLEMENTATION block from STB_TEXTEDIT_* to IMSTB_TEXTEDIT_*
 
@@ -32,7 +33,8 @@
 //
 // Uses the C runtime function 'memmove', which you can override
 // by defining IMSTB_TEXTEDIT_memmove before the implementation.
-// Uses no other functions. Performs no runtime allocations.
+// [DEAR IMGUI] The undo system allocates its storage with 'malloc'/'free',
+// which you can override by defining IMSTB_TEXTEDIT_malloc/IMSTB_TEXTEDIT_free.
 //
 //
 // VERSION HISTORY
@@ -86,19 +88,17 @@
 //   To compile in this mode, you must define STB_TEXTEDIT_CHARTYPE to a
 //   primitive type that defines a single character (e.g. char, wchar_t, etc).
 //
-//   To save space or increase undo-ability, you can optionally define the
-//   following things that are used by the undo system:
+//   To save space, you can optionally define the following things that
+//   are used by the undo system:
 //
 //      STB_TEXTEDIT_POSITIONTYPE         small int type encoding a valid cursor position
-//      STB_TEXTEDIT_UNDOSTATECOUNT       the number of undo states to allow
-//      STB_TEXTEDIT_UNDOCHARCOUNT        the number of characters to store in the undo buffer
 //
-//   If you don't define these, they are set to permissive types and
-//   moderate sizes. The undo system does no memory allocations, so
-//   it grows STB_TexteditState by the worst-case storage which is (in bytes):
-//
-//        [4 + 3 * sizeof(STB_TEXTEDIT_POSITIONTYPE)] * STB_TEXTEDIT_UNDOSTATECOUNT
-//      +          sizeof(STB_TEXTEDIT_CHARTYPE)      * STB_TEXTEDIT_UNDOCHARCOUNT
+//   [DEAR IMGUI] The undo system doesn't use fixed size arrays anymore.
+//   Records and characters are allocated on the first edit and grown as
+//   needed, as long as their total size stays under 'undostate.undo_size_max'
+//   bytes (the oldest records are discarded past that). Stored characters are
+//   UTF-8 encoded (up to 21-bit character values), and the storage is freed
+//   by stb_textedit_initialize_state() and stb_textedit_free_undo().
 //
 //
 // Implementation mode:
@@ -122,8 +122,6 @@
 //
 //     STB_TEXTEDIT_CHARTYPE             the character type
 //     STB_TEXTEDIT_POSITIONTYPE         small type that is a valid cursor position
-//     STB_TEXTEDIT_UNDOSTATECOUNT       the number of undo states to allow
-//     STB_TEXTEDIT_UNDOCHARCOUNT        the number of characters to store in the undo buffer
 //
 // Symbols you must define for implementation mode:
 //
@@ -175,6 +173,10 @@
 //    STB_TEXTEDIT_K_LINEEND2            secondary keyboard input to move cursor to end of line
 //    STB_TEXTEDIT_K_TEXTSTART2          secondary keyboard input to move cursor to start of text
 //    STB_TEXTEDIT_K_TEXTEND2            secondary keyboard input to move cursor to end of text
+//    IMSTB_TEXTEDIT_SEEKROW_Y(obj,y,&i,&row_y)                 [DEAR IMGUI] set 'i' and 'row_y' to the start of a row at or before the
+//                                                                  one straddling 'y', to skip laying out previous rows
+//    IMSTB_TEXTEDIT_SEEKROW_CHAR(obj,n,&i,&row_y,&prev_i)      [DEAR IMGUI] same for a row at or before the one containing character 'n',
+//                                                                  'prev_i' being the start of the row before it
 //
 // Keyboard input must be encoded as a single integer value; e.g. a character code
 // and some bitflags that represent shift states. to simplify the interface, SHIFT must
@@ -287,12 +289,6 @@
 // and undo state.
 //
 
-#ifndef IMSTB_TEXTEDIT_UNDOSTATECOUNT
-#define IMSTB_TEXTEDIT_UNDOSTATECOUNT   99
-#endif
-#ifndef IMSTB_TEXTEDIT_UNDOCHARCOUNT
-#define IMSTB_TEXTEDIT_UNDOCHARCOUNT   999
-#endif
 #ifndef IMSTB_TEXTEDIT_CHARTYPE
 #define IMSTB_TEXTEDIT_CHARTYPE        int
 #endif
@@ -312,10 +308,14 @@ typedef struct
 typedef struct
 {
    // private data
-   StbUndoRecord          undo_rec [IMSTB_TEXTEDIT_UNDOSTATECOUNT];
-   IMSTB_TEXTEDIT_CHARTYPE  undo_char[IMSTB_TEXTEDIT_UNDOCHARCOUNT];
-   short undo_point, redo_point;
+   // [DEAR IMGUI] Allocated on demand instead of fixed size arrays. Undo data grows from the start
+   // of each array and redo data from the end. 'undo_char' is UTF-8 so char points are byte offsets.
+   StbUndoRecord *undo_rec;
+   char *undo_char;
+   int undo_rec_count, undo_char_count;
+   int undo_point, redo_point;
    int undo_char_point, redo_char_point;
+   int undo_size_max; // maximum size of undo_rec[] + undo_char[] in bytes, set by user
 } StbUndoState;
 
 typedef struct
@@ -392,6 +392,12 @@ typedef struct
 #define IMSTB_TEXTEDIT_memmove memmove
 #endif
 
+#ifndef IMSTB_TEXTEDIT_malloc
+#include <stdlib.h>
+#define IMSTB_TEXTEDIT_malloc(sz) malloc(sz)
+#define IMSTB_TEXTEDIT_free(p)    free(p)
+#endif
+
 
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -411,6 +417,9 @@ static int stb_text_locate_coord(IMSTB_TEXTEDIT_STRING *str, float x, float y)
    r.num_chars = 0;
 
    // search rows to find one that straddles 'y'
+   #ifdef IMSTB_TEXTEDIT_SEEKROW_Y
+   IMSTB_TEXTEDIT_SEEKROW_Y(str, y, &i, &base_y); // [DEAR IMGUI]
+   #endif
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (r.num_chars <= 0)
@@ -539,6 +548,9 @@ static void stb_textedit_find_charpos(StbFindState *find, IMSTB_TEXTEDIT_STRING
 
    // search rows to find the one that straddles character n
    find->y = 0;
+   #ifdef IMSTB_TEXTEDIT_SEEKROW_CHAR
+   IMSTB_TEXTEDIT_SEEKROW_CHAR(str, n, &i, &find->y, &prev_start); // [DEAR IMGUI]
+   #endif
 
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -1111,10 +1123,153 @@ retry:
 //
 // @OPTIMIZE: the undo/redo buffer should be circular
 
+// [DEAR IMGUI] characters are stored UTF-8 encoded. Unlike regular UTF-8 decoders we don't
+// validate anything, so every character value round-trips (including e.g. lone surrogates).
+static int stb_text_undo_char_size(IMSTB_TEXTEDIT_CHARTYPE ch)
+{
+   unsigned int c = (unsigned int) ch;
+   return (c < 0x80) ? 1 : (c < 0x800) ? 2 : (c < 0x10000) ? 3 : 4;
+}
+
+static int stb_text_undo_encode_char(char *p, IMSTB_TEXTEDIT_CHARTYPE ch)
+{
+   unsigned int c = (unsigned int) ch;
+   if (c < 0x80)    { p[0] = (char) c; return 1; }
+   if (c < 0x800)   { p[0] = (char) (0xC0 | (c >> 6)); p[1] = (char) (0x80 | (c & 0x3F)); return 2; }
+   if (c < 0x10000) { p[0] = (char) (0xE0 | (c >> 12)); p[1] = (char) (0x80 | ((c >> 6) & 0x3F)); p[2] = (char) (0x80 | (c & 0x3F)); return 3; }
+   p[0] = (char) (0xF0 | ((c >> 18) & 0x07)); p[1] = (char) (0x80 | ((c >> 12) & 0x3F)); p[2] = (char) (0x80 | ((c >> 6) & 0x3F)); p[3] = (char) (0x80 | (c & 0x3F));
+   return 4;
+}
+
+static int stb_text_undo_decode_char(const char *p, IMSTB_TEXTEDIT_CHARTYPE *out)
+{
+   const unsigned char *s = (const unsigned char *) p;
+   if (s[0] < 0x80) { *out = (IMSTB_TEXTEDIT_CHARTYPE) s[0]; return 1; }
+   if (s[0] < 0xE0) { *out = (IMSTB_TEXTEDIT_CHARTYPE) (((s[0] & 0x1F) << 6) | (s[1] & 0x3F)); return 2; }
+   if (s[0] < 0xF0) { *out = (IMSTB_TEXTEDIT_CHARTYPE) (((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F)); return 3; }
+   *out = (IMSTB_TEXTEDIT_CHARTYPE) (((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F));
+   return 4;
+}
+
+// size in bytes of 'numchars' characters stored at 'p'
+static int stb_text_undo_storage_size(const char *p, int numchars)
+{
+   const unsigned char *s = (const unsigned char *) p;
+   int i;
+   for (i=0; i < numchars; ++i)
+      s += (s[0] < 0x80) ? 1 : (s[0] < 0xE0) ? 2 : (s[0] < 0xF0) ? 3 : 4;
+   return (int) (s - (const unsigned char *) p);
+}
+
+// size in bytes that characters [where, where+len) of the string will use once stored
+static int stb_text_undo_string_size(IMSTB_TEXTEDIT_STRING *str, int where, int len)
+{
+   int i, size = 0;
+   for (i=0; i < len; ++i)
+      size += stb_text_undo_char_size(STB_TEXTEDIT_GETCHAR(str, where+i));
+   return size;
+}
+
+static void stb_text_undo_store_string(IMSTB_TEXTEDIT_STRING *str, char *p, int where, int len)
+{
+   int i;
+   for (i=0; i < len; ++i)
+      p += stb_text_undo_encode_char(p, STB_TEXTEDIT_GETCHAR(str, where+i));
+}
+
+static void stb_text_undo_insert_stored(IMSTB_TEXTEDIT_STRING *str, int where, const char *p, int len)
+{
+   IMSTB_TEXTEDIT_CHARTYPE *buf = (IMSTB_TEXTEDIT_CHARTYPE *) IMSTB_TEXTEDIT_malloc(sizeof(IMSTB_TEXTEDIT_CHARTYPE) * (size_t) len);
+   int i;
+   if (buf == NULL)
+      return;
+   for (i=0; i < len; ++i)
+      p += stb_text_undo_decode_char(p, &buf[i]);
+   STB_TEXTEDIT_INSERTCHARS(str, where, buf, len);
+   IMSTB_TEXTEDIT_free(buf);
+}
+
+// [DEAR IMGUI] reallocate storage to 'rec_count' records and 'char_count' bytes of characters, keeping
+// undo data at the start of the arrays and moving redo data to their end. Both must still fit.
+static void stb_textedit_undo_realloc(StbUndoState *state, int rec_count, int char_count)
+{
+   StbUndoRecord *new_rec = (StbUndoRecord *) IMSTB_TEXTEDIT_malloc((size_t) rec_count * sizeof(StbUndoRecord));
+   char *new_char = (char *) IMSTB_TEXTEDIT_malloc((size_t) char_count);
+   int i, rec_delta, char_delta;
+   if (new_rec == NULL || new_char == NULL) {
+      if (new_rec) IMSTB_TEXTEDIT_free(new_rec);
+      if (new_char) IMSTB_TEXTEDIT_free(new_char);
+      return;
+   }
+   rec_delta = rec_count - state->undo_rec_count;
+   char_delta = char_count - state->undo_char_count;
+   if (state->undo_rec != NULL) {
+      IMSTB_TEXTEDIT_memmove(new_rec, state->undo_rec, (size_t) state->undo_point * sizeof(StbUndoRecord));
+      IMSTB_TEXTEDIT_memmove(new_rec + state->redo_point + rec_delta, state->undo_rec + state->redo_point, (size_t) (state->undo_rec_count - state->redo_point) * sizeof(StbUndoRecord));
+      IMSTB_TEXTEDIT_free(state->undo_rec);
+   }
+   if (state->undo_char != NULL) {
+      IMSTB_TEXTEDIT_memmove(new_char, state->undo_char, (size_t) state->undo_char_point);
+      IMSTB_TEXTEDIT_memmove(new_char + state->redo_char_point + char_delta, state->undo_char + state->redo_char_point, (size_t) (state->undo_char_count - state->redo_char_point));
+      IMSTB_TEXTEDIT_free(state->undo_char);
+   }
+   state->undo_rec = new_rec;
+   state->undo_char = new_char;
+   state->undo_rec_count = rec_count;
+   state->undo_char_count = char_count;
+   state->redo_point += rec_delta;
+   state->redo_char_point += char_delta;
+   for (i=state->redo_point; i < state->undo_rec_count; ++i)
+      if (state->undo_rec[i].char_storage >= 0)
+         state->undo_rec[i].char_storage += char_delta;
+}
+
+// [DEAR IMGUI] size to grow an array of 'count' elements to, to hold at least 'needed' elements: geometric
+// growth, clamped to the 'count_max' elements left by the budget. Returns 'count' when 'needed' doesn't fit.
+static size_t stb_textedit_undo_grow_count(size_t count, size_t needed, size_t count_min, size_t count_max)
+{
+   size_t n = count * 2 < count_min ? count_min : count * 2;
+   if (n < needed)
+      n = needed;
+   if (n > count_max)
+      n = count_max;
+   return n >= needed ? n : count;
+}
+
+// [DEAR IMGUI] grow storage toward 'rec_count' records and 'char_count' bytes of characters, without
+// going over 'undo_size_max'. Callers check the resulting capacities: when they are still too small
+// we fall back to discarding records.
+static void stb_textedit_undo_grow(StbUndoState *state, int rec_count, int char_count)
+{
+   const size_t size_max = state->undo_size_max > 0 ? (size_t) state->undo_size_max : 0;
+   size_t new_rec_count = (size_t) state->undo_rec_count;
+   size_t new_char_count = (size_t) state->undo_char_count;
+   if ((size_t) rec_count > new_rec_count && size_max > new_char_count)
+      new_rec_count = stb_textedit_undo_grow_count(new_rec_count, (size_t) rec_count, 16, (size_max - new_char_count) / sizeof(StbUndoRecord));
+   if ((size_t) char_count > new_char_count && size_max > new_rec_count * sizeof(StbUndoRecord))
+      new_char_count = stb_textedit_undo_grow_count(new_char_count, (size_t) char_count, 256, size_max - new_rec_count * sizeof(StbUndoRecord));
+   if (new_rec_count != (size_t) state->undo_rec_count || new_char_count != (size_t) state->undo_char_count)
+      stb_textedit_undo_realloc(state, (int) new_rec_count, (int) new_char_count);
+}
+
+// [DEAR IMGUI] release undo storage, clearing undo/redo history
+static void stb_textedit_free_undo(StbUndoState *state)
+{
+   if (state->undo_rec != NULL)
+      IMSTB_TEXTEDIT_free(state->undo_rec);
+   if (state->undo_char != NULL)
+      IMSTB_TEXTEDIT_free(state->undo_char);
+   state->undo_rec = NULL;
+   state->undo_char = NULL;
+   state->undo_rec_count = state->undo_char_count = 0;
+   state->undo_point = state->redo_point = 0;
+   state->undo_char_point = state->redo_char_point = 0;
+}
+
 static void stb_textedit_flush_redo(StbUndoState *state)
 {
-   state->redo_point = IMSTB_TEXTEDIT_UNDOSTATECOUNT;
-   state->redo_char_point = IMSTB_TEXTEDIT_UNDOCHARCOUNT;
+   state->redo_point = state->undo_rec_count;
+   state->redo_char_point = state->undo_char_count;
 }
 
 // discard the oldest entry in the undo list
@@ -1123,10 +1278,10 @@ static void stb_textedit_discard_undo(StbUndoState *state)
    if (state->undo_point > 0) {
       // if the 0th undo state has characters, clean those up
       if (state->undo_rec[0].char_storage >= 0) {
-         int n = state->undo_rec[0].insert_length, i;
+         int n = stb_text_undo_storage_size(state->undo_char + state->undo_rec[0].char_storage, state->undo_rec[0].insert_length), i;
          // delete n characters from all other records
          state->undo_char_point -= n;
-         IMSTB_TEXTEDIT_memmove(state->undo_char, state->undo_char + n, (size_t) (state->undo_char_point*sizeof(IMSTB_TEXTEDIT_CHARTYPE)));
+         IMSTB_TEXTEDIT_memmove(state->undo_char, state->undo_char + n, (size_t) state->undo_char_point);
          for (i=0; i < state->undo_point; ++i)
             if (state->undo_rec[i].char_storage >= 0)
                state->undo_rec[i].char_storage -= n; // @OPTIMIZE: get rid of char_storage and infer it
@@ -1142,15 +1297,15 @@ static void stb_textedit_discard_undo(StbUndoState *state)
 // fill up even though the undo buffer didn't
 static void stb_textedit_discard_redo(StbUndoState *state)
 {
-   int k = IMSTB_TEXTEDIT_UNDOSTATECOUNT-1;
+   int k = state->undo_rec_count-1;
 
    if (state->redo_point <= k) {
       // if the k'th undo state has characters, clean those up
       if (state->undo_rec[k].char_storage >= 0) {
-         int n = state->undo_rec[k].insert_length, i;
+         int n = stb_text_undo_storage_size(state->undo_char + state->undo_rec[k].char_storage, state->undo_rec[k].insert_length), i;
          // move the remaining redo character data to the end of the buffer
          state->redo_char_point += n;
-         IMSTB_TEXTEDIT_memmove(state->undo_char + state->redo_char_point, state->undo_char + state->redo_char_point-n, (size_t) ((IMSTB_TEXTEDIT_UNDOCHARCOUNT - state->redo_char_point)*sizeof(IMSTB_TEXTEDIT_CHARTYPE)));
+         IMSTB_TEXTEDIT_memmove(state->undo_char + state->redo_char_point, state->undo_char + state->redo_char_point-n, (size_t) (state->undo_char_count - state->redo_char_point));
          // adjust the position of all the other records to account for above memmove
          for (i=state->redo_point; i < k; ++i)
             if (state->undo_rec[i].char_storage >= 0)
@@ -1158,9 +1313,9 @@ static void stb_textedit_discard_redo(StbUndoState *state)
       }
       // now move all the redo records towards the end of the buffer; the first one is at 'redo_point'
       // [DEAR IMGUI]
-      size_t move_size = (size_t)((IMSTB_TEXTEDIT_UNDOSTATECOUNT - state->redo_point - 1) * sizeof(state->undo_rec[0]));
+      size_t move_size = (size_t)((state->undo_rec_count - state->redo_point - 1) * sizeof(state->undo_rec[0]));
       const char* buf_begin = (char*)state->undo_rec; (void)buf_begin;
-      const char* buf_end   = (char*)state->undo_rec + sizeof(state->undo_rec); (void)buf_end;
+      const char* buf_end   = (char*)(state->undo_rec + state->undo_rec_count); (void)buf_end;
       IM_ASSERT(((char*)(state->undo_rec + state->redo_point)) >= buf_begin);
       IM_ASSERT(((char*)(state->undo_rec + state->redo_point + 1) + move_size) <= buf_end);
       IMSTB_TEXTEDIT_memmove(state->undo_rec + state->redo_point+1, state->undo_rec + state->redo_point, move_size);
@@ -1170,33 +1325,67 @@ static void stb_textedit_discard_redo(StbUndoState *state)
    }
 }
 
+// [DEAR IMGUI] the records use the part of the budget that 'numchars' more bytes of characters need (e.g. after
+// typing many characters, which store none): discard the oldest records and give their space to characters,
+// instead of clearing the whole history. Only called when there is no redo data.
+static void stb_textedit_undo_make_char_room(StbUndoState *state, int numchars)
+{
+   const size_t size_max = state->undo_size_max > 0 ? (size_t) state->undo_size_max : 0;
+   while (state->undo_char_point + numchars > state->undo_char_count) {
+      // keep room for existing undo records, plus the one being created
+      const size_t char_needed = (size_t) (state->undo_char_point + numchars);
+      const size_t rec_keep_size = (size_t) (state->undo_point + 1) * sizeof(StbUndoRecord);
+      if (rec_keep_size + char_needed <= size_max) {
+         size_t new_char_count = stb_textedit_undo_grow_count((size_t) state->undo_char_count, char_needed, 256, size_max - rec_keep_size);
+         size_t new_rec_count = (size_max - new_char_count) / sizeof(StbUndoRecord);
+         if (new_rec_count > (size_t) state->undo_rec_count)
+            new_rec_count = (size_t) state->undo_rec_count;
+         stb_textedit_undo_realloc(state, (int) new_rec_count, (int) new_char_count);
+         return;
+      }
+      if (state->undo_point == 0)
+         return;
+      stb_textedit_discard_undo(state);
+   }
+}
+
+// [DEAR IMGUI] 'numchars' is the size of the characters to store, in bytes
 static StbUndoRecord *stb_text_create_undo_record(StbUndoState *state, int numchars)
 {
    // any time we create a new undo record, we discard redo
    stb_textedit_flush_redo(state);
 
+   // [DEAR IMGUI] grow storage if we can, before falling back on discarding old records
+   if (state->undo_point == state->undo_rec_count || state->undo_char_point + numchars > state->undo_char_count)
+      stb_textedit_undo_grow(state, state->undo_point + 1, state->undo_char_point + numchars);
+   if (state->undo_char_point + numchars > state->undo_char_count)
+      stb_textedit_undo_make_char_room(state, numchars);
+   if (state->undo_rec_count == 0)
+      return NULL;
+
    // if we have no free records, we have to make room, by sliding the
    // existing records down
-   if (state->undo_point == IMSTB_TEXTEDIT_UNDOSTATECOUNT)
+   if (state->undo_point == state->undo_rec_count)
       stb_textedit_discard_undo(state);
 
    // if the characters to store won't possibly fit in the buffer, we can't undo
-   if (numchars > IMSTB_TEXTEDIT_UNDOCHARCOUNT) {
+   if (numchars > state->undo_char_count) {
       state->undo_point = 0;
       state->undo_char_point = 0;
       return NULL;
    }
 
    // if we don't have enough free characters in the buffer, we have to make room
-   while (state->undo_char_point + numchars > IMSTB_TEXTEDIT_UNDOCHARCOUNT)
+   while (state->undo_char_point + numchars > state->undo_char_count)
       stb_textedit_discard_undo(state);
 
    return &state->undo_rec[state->undo_point++];
 }
 
-static IMSTB_TEXTEDIT_CHARTYPE *stb_text_createundo(StbUndoState *state, int pos, int insert_len, int delete_len)
+// [DEAR IMGUI] returns storage for 'insert_size' bytes (the UTF-8 encoding of 'insert_len' characters)
+static char *stb_text_createundo(StbUndoState *state, int pos, int insert_len, int delete_len, int insert_size)
 {
-   StbUndoRecord *r = stb_text_create_undo_record(state, insert_len);
+   StbUndoRecord *r = stb_text_create_undo_record(state, insert_size);
    if (r == NULL)
       return NULL;
 
@@ -1209,7 +1398,7 @@ static IMSTB_TEXTEDIT_CHARTYPE *stb_text_createundo(StbUndoState *state, int pos
       return NULL;
    } else {
       r->char_storage = state->undo_char_point;
-      state->undo_char_point += insert_len;
+      state->undo_char_point += insert_size;
       return &state->undo_char[r->char_storage];
    }
 }
@@ -1218,9 +1407,17 @@ static void stb_text_undo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
 {
    StbUndoState *s = &state->undostate;
    StbUndoRecord u, *r;
+   int delete_size = 0;
    if (s->undo_point == 0)
       return;
 
+   // [DEAR IMGUI] make room for the characters we need to store for redo (this may move records)
+   if (s->undo_rec[s->undo_point-1].delete_length) {
+      delete_size = stb_text_undo_string_size(str, s->undo_rec[s->undo_point-1].where, s->undo_rec[s->undo_point-1].delete_length);
+      if (s->undo_char_point + delete_size >= s->redo_char_point)
+         stb_textedit_undo_grow(s, s->undo_rec_count, s->undo_char_point + delete_size + (s->undo_char_count - s->redo_char_point) + 1);
+   }
+
    // we need to do two things: apply the undo record, and create a redo record
    u = s->undo_rec[s->undo_point-1];
    r = &s->undo_rec[s->redo_point-1];
@@ -1241,28 +1438,25 @@ static void stb_text_undo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
       //    characters stored for *undoing* don't leave room for redo
       // if the last is true, we have to bail
 
-      if (s->undo_char_point + u.delete_length >= IMSTB_TEXTEDIT_UNDOCHARCOUNT) {
+      if (s->undo_char_point + delete_size >= s->undo_char_count) {
          // the undo records take up too much character space; there's no space to store the redo characters
          r->insert_length = 0;
       } else {
-         int i;
-
          // there's definitely room to store the characters eventually
-         while (s->undo_char_point + u.delete_length > s->redo_char_point) {
+         while (s->undo_char_point + delete_size > s->redo_char_point) {
             // should never happen:
-            if (s->redo_point == IMSTB_TEXTEDIT_UNDOSTATECOUNT)
+            if (s->redo_point == s->undo_rec_count)
                return;
             // there's currently not enough room, so discard a redo record
             stb_textedit_discard_redo(s);
          }
          r = &s->undo_rec[s->redo_point-1];
 
-         r->char_storage = s->redo_char_point - u.delete_length;
-         s->redo_char_point = s->redo_char_point - u.delete_length;
+         r->char_storage = s->redo_char_point - delete_size;
+         s->redo_char_point = s->redo_char_point - delete_size;
 
          // now save the characters
-         for (i=0; i < u.delete_length; ++i)
-            s->undo_char[r->char_storage + i] = STB_TEXTEDIT_GETCHAR(str, u.where + i);
+         stb_text_undo_store_string(str, s->undo_char + r->char_storage, u.where, u.delete_length);
       }
 
       // now we can carry out the deletion
@@ -1272,8 +1466,8 @@ static void stb_text_undo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
    // check type of recorded action:
    if (u.insert_length) {
       // easy case: was a deletion, so we need to insert n characters
-      STB_TEXTEDIT_INSERTCHARS(str, u.where, &s->undo_char[u.char_storage], u.insert_length);
-      s->undo_char_point -= u.insert_length;
+      stb_text_undo_insert_stored(str, u.where, s->undo_char + u.char_storage, u.insert_length);
+      s->undo_char_point -= stb_text_undo_storage_size(s->undo_char + u.char_storage, u.insert_length);
    }
 
    state->cursor = u.where + u.insert_length;
@@ -1286,9 +1480,17 @@ static void stb_text_redo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
 {
    StbUndoState *s = &state->undostate;
    StbUndoRecord *u, r;
-   if (s->redo_point == IMSTB_TEXTEDIT_UNDOSTATECOUNT)
+   int delete_size = 0;
+   if (s->redo_point == s->undo_rec_count)
       return;
 
+   // [DEAR IMGUI] make room for the characters we need to store for undo (this may move records)
+   if (s->undo_rec[s->redo_point].delete_length) {
+      delete_size = stb_text_undo_string_size(str, s->undo_rec[s->redo_point].where, s->undo_rec[s->redo_point].delete_length);
+      if (s->undo_char_point + delete_size > s->redo_char_point)
+         stb_textedit_undo_grow(s, s->undo_rec_count, s->undo_char_point + delete_size + (s->undo_char_count - s->redo_char_point));
+   }
+
    // we need to do two things: apply the redo record, and create an undo record
    u = &s->undo_rec[s->undo_point];
    r = s->undo_rec[s->redo_point];
@@ -1305,17 +1507,15 @@ static void stb_text_redo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
       // the redo record requires us to delete characters, so the undo record
       // needs to store the characters
 
-      if (s->undo_char_point + u->insert_length > s->redo_char_point) {
+      if (s->undo_char_point + delete_size > s->redo_char_point) {
          u->insert_length = 0;
          u->delete_length = 0;
       } else {
-         int i;
          u->char_storage = s->undo_char_point;
-         s->undo_char_point = s->undo_char_point + u->insert_length;
+         s->undo_char_point = s->undo_char_point + delete_size;
 
          // now save the characters
-         for (i=0; i < u->insert_length; ++i)
-            s->undo_char[u->char_storage + i] = STB_TEXTEDIT_GETCHAR(str, u->where + i);
+         stb_text_undo_store_string(str, s->undo_char + u->char_storage, u->where, u->insert_length);
       }
 
       STB_TEXTEDIT_DELETECHARS(str, r.where, r.delete_length);
@@ -1323,8 +1523,8 @@ static void stb_text_redo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
 
    if (r.insert_length) {
       // easy case: need to insert n characters
-      STB_TEXTEDIT_INSERTCHARS(str, r.where, &s->undo_char[r.char_storage], r.insert_length);
-      s->redo_char_point += r.insert_length;
+      stb_text_undo_insert_stored(str, r.where, s->undo_char + r.char_storage, r.insert_length);
+      s->redo_char_point += stb_text_undo_storage_size(s->undo_char + r.char_storage, r.insert_length);
    }
 
    state->cursor = r.where + r.insert_length;
@@ -1335,27 +1535,21 @@ static void stb_text_redo(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state)
 
 static void stb_text_makeundo_insert(STB_TexteditState *state, int where, int length)
 {
-   stb_text_createundo(&state->undostate, where, 0, length);
+   stb_text_createundo(&state->undostate, where, 0, length, 0);
 }
 
 static void stb_text_makeundo_delete(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int length)
 {
-   int i;
-   IMSTB_TEXTEDIT_CHARTYPE *p = stb_text_createundo(&state->undostate, where, length, 0);
-   if (p) {
-      for (i=0; i < length; ++i)
-         p[i] = STB_TEXTEDIT_GETCHAR(str, where+i);
-   }
+   char *p = stb_text_createundo(&state->undostate, where, length, 0, stb_text_undo_string_size(str, where, length));
+   if (p)
+      stb_text_undo_store_string(str, p, where, length);
 }
 
 static void stb_text_makeundo_replace(IMSTB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, int new_length)
 {
-   int i;
-   IMSTB_TEXTEDIT_CHARTYPE *p = stb_text_createundo(&state->undostate, where, old_length, new_length);
-   if (p) {
-      for (i=0; i < old_length; ++i)
-         p[i] = STB_TEXTEDIT_GETCHAR(str, where+i);
-   }
+   char *p = stb_text_createundo(&state->undostate, where, old_length, new_length, stb_text_undo_string_size(str, where, old_length));
+   if (p)
+      stb_text_undo_store_string(str, p, where, old_length);
 }
 
 // reset the state to default
@@ -1363,8 +1557,8 @@ static void stb_textedit_clear_state(STB_TexteditState *state, int is_single_lin
 {
    state->undostate.undo_point = 0;
    state->undostate.undo_char_point = 0;
-   state->undostate.redo_point = IMSTB_TEXTEDIT_UNDOSTATECOUNT;
-   state->undostate.redo_char_point = IMSTB_TEXTEDIT_UNDOCHARCOUNT;
+   state->undostate.redo_point = state->undostate.undo_rec_count;
+   state->undostate.redo_char_point = state->undostate.undo_char_count;
    state->select_end = state->select_start = 0;
    state->cursor = 0;
    state->has_preferred_x = 0;
@@ -1379,6 +1573,7 @@ static void stb_textedit_clear_state(STB_TexteditState *state, int is_single_lin
 // API initialize
 static void stb_textedit_initialize_state(STB_TexteditState *state, int is_single_line)
 {
+   stb_textedit_free_undo(&state->undostate); // [DEAR IMGUI] storage is reallocated on the next edit
    stb_textedit_clear_state(state, is_single_line);
 }
 
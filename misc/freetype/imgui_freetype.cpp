@@ -6,6 +6,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2024/05/06: added support for ImFontAtlasFlags_SDF (require FreeType 2.11+): glyphs are rendered with FT_RENDER_MODE_SDF using ImFontAtlas::SdfSpread.
+//  2024/05/06: render glyphs of each source font as a separate job through io.ParallelForFn (when set). Output is unchanged.
 //  2023/11/13: added support for ImFontConfig::RasterizationDensity field for scaling render density without scaling metrics.
 //  2023/08/01: added support for SVG fonts, enable by using '#define IMGUI_ENABLE_FREETYPE_LUNASVG' (#6591)
 //  2023/01/04: fixed a packing issue which in some occurrences would prevent large amount of glyphs from being packed correctly.
@@ -74,8 +76,10 @@
 //-------------------------------------------------------------------------
 
 // Default memory allocators
-static void* ImGuiFreeTypeDefaultAllocFunc(size_t size, void* user_data) { IM_UNUSED(user_data); return IM_ALLOC(size); }
-static void  ImGuiFreeTypeDefaultFreeFunc(void* ptr, void* user_data) { IM_UNUSED(user_data); IM_FREE(ptr); }
+// Glyphs may be rendered from concurrent jobs (see ImGui::ParallelFor()): we call ImGui allocator functions directly,
+// as the debug allocation tracking done by ImGui::MemAlloc()/MemFree() is not thread-safe.
+static void* ImGuiFreeTypeDefaultAllocFunc(size_t size, void* user_data) { IM_UNUSED(user_data); ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* alloc_user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &alloc_user_data); return alloc_func(size, alloc_user_data); }
+static void  ImGuiFreeTypeDefaultFreeFunc(void* ptr, void* user_data) { IM_UNUSED(user_data); ImGuiMemAllocFunc alloc_func; ImGuiMemFreeFunc free_func; void* alloc_user_data; ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &alloc_user_data); free_func(ptr, alloc_user_data); }
 
 // Current memory allocators
 static void* (*GImGuiFreeTypeAllocFunc)(size_t size, void* user_data) = ImGuiFreeTypeDefaultAllocFunc;
@@ -419,6 +423,8 @@ struct ImFontBuildSrcDataFT
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<ImFontBuildSrcGlyphFT>   GlyphsList;
+    unsigned char*      BitmapBuffers;      // Temporary rasterization data, per source font so sources can be rendered concurrently. Chunks are chained through their first bytes, so jobs don't need to allocate via ImVector<>.
+    int                 BitmapBuffersCurrentUsedBytes;
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -430,12 +436,95 @@ struct ImFontBuildDstDataFT
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Load and render glyphs of one source font into temporary buffers, and gather the sizes of all rectangles we will need to pack.
+// We could not find a way to retrieve accurate glyph size without rendering them.
+// (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
+// We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't mind the temporary allocations.
+// This is called from ImGui::ParallelFor() with one job per source font: a FT_Face must only be used by one thread at a time,
+// but different faces of a same FT_Library may be used concurrently.
+static const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
+static const int BITMAP_BUFFERS_CHUNK_HEADER_SIZE = 16;    // Pointer to previous chunk (rounded up to keep glyph data aligned)
+
+struct ImFontBuildJobsDataFT
+{
+    ImFontAtlas*            Atlas;
+    ImFontBuildSrcDataFT*   SrcTmpArray;
+};
+
+static void ImFontAtlasBuildRenderSrcGlyphsJob(void* job_data, int src_i)
+{
+    ImFontBuildJobsDataFT* data = (ImFontBuildJobsDataFT*)job_data;
+    ImFontBuildSrcDataFT& src_tmp = data->SrcTmpArray[src_i];
+    ImFontConfig& cfg = data->Atlas->ConfigData[src_i];
+    if (src_tmp.GlyphsCount == 0)
+        return;
+
+    // Compute multiply table if requested (distance fields are not coverage values: RasterizerMultiply is ignored with ImFontAtlasFlags_SDF)
+    const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f) && !(data->Atlas->Flags & ImFontAtlasFlags_SDF);
+    unsigned char multiply_table[256];
+    if (multiply_enabled)
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+
+    // Gather the sizes of all rectangles we will need to pack
+    const int padding = data->Atlas->TexGlyphPadding;
+    src_tmp.BitmapBuffersCurrentUsedBytes = BITMAP_BUFFERS_CHUNK_SIZE;
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+
+        const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
+        if (metrics == nullptr)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
+        if (ft_bitmap == nullptr)
+            continue;
+
+        // Allocate new temporary chunk if needed
+        const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
+        if (src_tmp.BitmapBuffersCurrentUsedBytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
+        {
+            unsigned char* new_chunk = (unsigned char*)GImGuiFreeTypeAllocFunc(BITMAP_BUFFERS_CHUNK_SIZE, GImGuiFreeTypeAllocatorUserData);
+            *(unsigned char**)(void*)new_chunk = src_tmp.BitmapBuffers;
+            src_tmp.BitmapBuffers = new_chunk;
+            src_tmp.BitmapBuffersCurrentUsedBytes = BITMAP_BUFFERS_CHUNK_HEADER_SIZE;
+        }
+        IM_ASSERT(src_tmp.BitmapBuffersCurrentUsedBytes + bitmap_size_in_bytes <= BITMAP_BUFFERS_CHUNK_SIZE); // We could probably allocate custom-sized buffer instead.
+
+        // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
+        src_glyph.BitmapData = (unsigned int*)(void*)(src_tmp.BitmapBuffers + src_tmp.BitmapBuffersCurrentUsedBytes);
+        src_tmp.BitmapBuffersCurrentUsedBytes += bitmap_size_in_bytes;
+        src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : nullptr);
+
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
+    }
+}
+
 bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
 
     ImFontAtlasBuildInit(atlas);
 
+    // Distance fields are rendered by FreeType's 'sdf' (outlines) and 'bsdf' (bitmaps) modules, which share our output convention:
+    // texels are 128 on the outline and change by 128/spread per texel, higher inside. The spread is a property of the library.
+    const bool sdf = (atlas->Flags & ImFontAtlasFlags_SDF) != 0;
+#if ((FREETYPE_MAJOR >= 2) && (FREETYPE_MINOR >= 11))
+    if (sdf)
+    {
+        IM_ASSERT(atlas->SdfSpread >= 2 && atlas->SdfSpread <= 32 && "FreeType only supports a SdfSpread between 2 and 32!");
+        FT_Int spread = (FT_Int)atlas->SdfSpread;
+        FT_Property_Set(ft_library, "sdf", "spread", &spread);
+        FT_Property_Set(ft_library, "bsdf", "spread", &spread);
+    }
+#else
+    IM_ASSERT(!sdf && "ImFontAtlasFlags_SDF requires FreeType 2.11+!");
+    if (sdf)
+        return false;
+#endif
+
     // Clear atlas
     atlas->TexID = 0;
     atlas->TexWidth = atlas->TexHeight = 0;
@@ -472,6 +561,10 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
         // Load font
         if (!font_face.InitFont(ft_library, cfg, extra_flags))
             return false;
+#if ((FREETYPE_MAJOR >= 2) && (FREETYPE_MINOR >= 11))
+        if (sdf)
+            font_face.RenderMode = FT_RENDER_MODE_SDF; // Overrides ImGuiFreeTypeBuilderFlags_Monochrome
+#endif
 
         // Measure highest codepoints
         src_load_color |= (cfg.FontBuilderFlags & ImGuiFreeTypeBuilderFlags_LoadColor) != 0;
@@ -548,69 +641,28 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     buf_rects.resize(total_glyphs_count);
     memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
 
-    // Allocate temporary rasterization data buffers.
-    // We could not find a way to retrieve accurate glyph size without rendering them.
-    // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
-    // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't mind the temporary allocations.
-    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
-    int buf_bitmap_current_used_bytes = 0;
-    ImVector<unsigned char*> buf_bitmap_buffers;
-    buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     // 8. Render/rasterize font characters into the texture
-    int total_surface = 0;
+    // (Rendering is done through io.ParallelForFn, one job per source font. Packing stays serial so output is identical to a serial build)
     int buf_rects_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
-
         src_tmp.Rects = &buf_rects[buf_rects_out_n];
         buf_rects_out_n += src_tmp.GlyphsCount;
-
-        // Compute multiply table if requested
-        const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
-        unsigned char multiply_table[256];
-        if (multiply_enabled)
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-
-        // Gather the sizes of all rectangles we will need to pack
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
-        {
-            ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
-
-            const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
-            if (metrics == nullptr)
-                continue;
-
-            // Render glyph into a bitmap (currently held by FreeType)
-            const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
-            if (ft_bitmap == nullptr)
-                continue;
-
-            // Allocate new temporary chunk if needed
-            const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
-            if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
-            {
-                buf_bitmap_current_used_bytes = 0;
-                buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-            }
-            IM_ASSERT(buf_bitmap_current_used_bytes + bitmap_size_in_bytes <= BITMAP_BUFFERS_CHUNK_SIZE); // We could probably allocate custom-sized buffer instead.
-
-            // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
-            src_glyph.BitmapData = (unsigned int*)(buf_bitmap_buffers.back() + buf_bitmap_current_used_bytes);
-            buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
-            src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : nullptr);
-
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
-        }
     }
+    ImFontBuildJobsDataFT jobs_data = { atlas, src_tmp_array.Data };
+#ifdef IMGUI_ENABLE_FREETYPE_LUNASVG
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++) // SVG hooks share their state across faces: render serially
+        ImFontAtlasBuildRenderSrcGlyphsJob(&jobs_data, src_i);
+#else
+    ImGui::ParallelFor(src_tmp_array.Size, ImFontAtlasBuildRenderSrcGlyphsJob, &jobs_data);
+#endif
+    int total_surface = 0;
+    for (const stbrp_rect& rect : buf_rects)
+        total_surface += rect.w * rect.h;
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
@@ -741,8 +793,12 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     atlas->TexPixelsUseColors = tex_use_colors;
 
     // Cleanup
-    for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
-        IM_FREE(buf_bitmap_buffers[buf_i]);
+    for (ImFontBuildSrcDataFT& src_tmp : src_tmp_array)
+        while (unsigned char* bitmap_buffer = src_tmp.BitmapBuffers)
+        {
+            src_tmp.BitmapBuffers = *(unsigned char**)(void*)bitmap_buffer;
+            GImGuiFreeTypeFreeFunc(bitmap_buffer, GImGuiFreeTypeAllocatorUserData);
+        }
     src_tmp_array.clear_destruct();
 
     ImFontAtlasBuildFinish(atlas);
@@ -0,0 +1,256 @@
+// dear imgui: checks of internal invariants
+// (compile and link imgui, create context, run headless with NO INPUTS, NO GRAPHICS OUTPUT)
+// Build and run with 'make test'. Failed checks are printed and the program returns 1.
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+static int g_checks_count = 0;
+static int g_checks_failed = 0;
+
+#define IM_CHECK(_EXPR)     do { g_checks_count++; if (!(_EXPR)) { g_checks_failed++; printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #_EXPR); } } while (0)
+
+static void CreateTestContext()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = NULL;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+}
+
+//-----------------------------------------------------------------------------
+// Font atlas cache
+//-----------------------------------------------------------------------------
+
+// A valid cache is restored, a truncated or corrupted cache is rejected and leaves the atlas untouched.
+static void TestFontAtlasCache()
+{
+    CreateTestContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImVector<unsigned char> cache;
+    IM_CHECK(atlas->SaveCacheToMemory(&cache));
+    IM_CHECK(atlas->LoadCacheFromMemory(cache.Data, (size_t)cache.Size));
+    IM_CHECK(atlas->IsBuilt());
+
+    // Truncated at every byte of the beginning and end of the data, and at regular intervals in between
+    const ImFontGlyph* glyph_a = atlas->Fonts[0]->FindGlyphNoFallback('A');
+    const ImFontGlyph glyph_a_backup = *glyph_a;
+    int truncated_accepted = 0;
+    for (int size = 0; size < cache.Size; size += (size < 1024 || size >= cache.Size - 1024) ? 1 : 997)
+        if (atlas->LoadCacheFromMemory(cache.Data, (size_t)size))
+            truncated_accepted++;
+    IM_CHECK(truncated_accepted == 0);
+    IM_CHECK(atlas->IsBuilt());
+    IM_CHECK(memcmp(atlas->Fonts[0]->FindGlyphNoFallback('A'), &glyph_a_backup, sizeof(ImFontGlyph)) == 0);
+
+    // Cache ends with IndexLookup[] of the last font: an out of range glyph index is rejected
+    const ImWchar bad_glyph_index = (ImWchar)0xFFFE;
+    memcpy(cache.Data + cache.Size - sizeof(ImWchar), &bad_glyph_index, sizeof(ImWchar));
+    IM_CHECK(!atlas->LoadCacheFromMemory(cache.Data, (size_t)cache.Size));
+    IM_CHECK(atlas->IsBuilt());
+
+    // Atlas is still usable
+    ImGui::NewFrame();
+    ImGui::Text("Hello, world!");
+    ImGui::Render();
+    ImGui::DestroyContext();
+}
+
+//-----------------------------------------------------------------------------
+// Text wrapping
+//-----------------------------------------------------------------------------
+
+// Reference: ImFont::CalcWordWrapPositionA() decoding and measuring one character at a time, without the printable ASCII fast path.
+static const char* CalcWordWrapPositionReference(const ImFont* font, float scale, const char* text, const char* text_end, float wrap_width)
+{
+    float line_width = 0.0f, word_width = 0.0f, blank_width = 0.0f;
+    wrap_width /= scale;
+    const char* word_end = text;
+    const char* prev_word_end = NULL;
+    bool inside_word = true;
+    const char* s = text;
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        const char* next_s = (c < 0x80) ? s + 1 : s + ImTextCharFromUtf8(&c, s, text_end);
+        if (c == '\n')
+        {
+            line_width = word_width = blank_width = 0.0f;
+            inside_word = true;
+            s = next_s;
+            continue;
+        }
+        if (c == '\r')
+        {
+            s = next_s;
+            continue;
+        }
+        const float char_width = font->GetCharAdvance((ImWchar)c);
+        if (ImCharIsBlankW(c))
+        {
+            if (inside_word)
+            {
+                line_width += blank_width;
+                blank_width = 0.0f;
+                word_end = s;
+            }
+            blank_width += char_width;
+            inside_word = false;
+        }
+        else
+        {
+            word_width += char_width;
+            if (inside_word)
+            {
+                word_end = next_s;
+            }
+            else
+            {
+                prev_word_end = word_end;
+                line_width += word_width + blank_width;
+                word_width = blank_width = 0.0f;
+            }
+            inside_word = (c != '.' && c != ',' && c != ';' && c != '!' && c != '?' && c != '\"');
+        }
+        if (line_width + word_width > wrap_width)
+        {
+            if (word_width < wrap_width)
+                s = prev_word_end ? prev_word_end : word_end;
+            break;
+        }
+        s = next_s;
+    }
+    if (s == text && text < text_end)
+        return s + 1;
+    return s;
+}
+
+// Mixed ASCII/UTF-8 text, with printable ASCII runs shorter and longer than 16 bytes (the SSE2 block size) and starting at any alignment.
+static void TestTextWrapMixedUtf8()
+{
+    CreateTestContext();
+    const ImFont* font = ImGui::GetIO().Fonts->Fonts[0];
+    static const char* pieces[] =
+    {
+        "word", "wrapping", "a", "Supercalifragilisticexpialidocious", " ", "  ", "\t", ".", ", ", "!?", "\"quoted\"", "\n", "\r\n",
+        "caf\xC3\xA9", "\xC3\xA0 la", "\xE4\xB8\xAD\xE6\x96\x87", "\xE3\x80\x80", "\xF0\x9F\x98\x80", "\xC2\xA0", "\x80", "\x01", "\x7F",
+    };
+    char text[4096];
+    int text_len = 0;
+    for (unsigned int rand_state = 1; text_len < IM_ARRAYSIZE(text) - 64; )
+    {
+        rand_state = rand_state * 1103515245u + 12345u;
+        const char* piece = pieces[(rand_state >> 16) % IM_ARRAYSIZE(pieces)];
+        memcpy(text + text_len, piece, strlen(piece));
+        text_len += (int)strlen(piece);
+    }
+    const char* text_end = text + text_len;
+
+    int mismatches = 0;
+    const float wrap_widths[] = { 1.0f, 7.0f, 30.0f, 64.5f, 100.0f, 333.0f, 2000.0f };
+    const float scales[] = { 1.0f, 1.5f };
+    for (float scale : scales)
+        for (float wrap_width : wrap_widths)
+            for (const char* s = text; s < text_end; s++)
+                if (font->CalcWordWrapPositionA(scale, s, text_end, wrap_width) != CalcWordWrapPositionReference(font, scale, s, text_end, wrap_width))
+                    mismatches++;
+    IM_CHECK(mismatches == 0);
+
+    ImGui::DestroyContext();
+}
+
+//-----------------------------------------------------------------------------
+// List clipper
+//-----------------------------------------------------------------------------
+
+static float ClipperTestItemHeight(int item_n) { return (float)(10 + (item_n % 7) * 13); }
+
+// ImGuiListClipper::BeginVariableHeight(): items are laid out at the sum of heights of previous items, and content height
+// (hence ScrollMax) matches the sum of all heights, with measured heights or estimates for items which weren't displayed yet.
+static void TestClipperVariableHeight()
+{
+    CreateTestContext();
+    ImGuiContext& g = *GImGui;
+    const int items_count = 10000;
+    const float items_height_estimate = 20.0f;
+    const float spacing_y = g.Style.ItemSpacing.y;
+    const float scroll_targets[] = { 0.0f, 5000.0f, 123456.0f, FLT_MAX, 2000.0f, 0.0f };
+
+    for (int known_heights = 1; known_heights >= 0; known_heights--)
+    {
+        ImVector<bool> measured;
+        measured.resize(items_count, known_heights ? true : false);
+        float expected_content_height = 0.0f;
+        int positions_mismatches = 0, coverage_errors = 0;
+        for (int frame = 0; frame < IM_ARRAYSIZE(scroll_targets) * 2; frame++)
+        {
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+            ImGui::SetNextWindowSize(ImVec2(400.0f, 500.0f));
+            ImGui::Begin(known_heights ? "Clipper known heights" : "Clipper measured heights", NULL, ImGuiWindowFlags_NoSavedSettings);
+            ImGuiWindow* window = g.CurrentWindow;
+            if (frame > 0)
+            {
+                // Content size and scroll range are calculated by Begin() from the previous frame
+                IM_CHECK(window->ContentSize.y == expected_content_height);
+                IM_CHECK(window->ScrollMax.y == ImMax(0.0f, expected_content_height + window->WindowPadding.y * 2.0f - window->InnerRect.GetHeight()));
+            }
+            if ((frame & 1) == 0)
+                ImGui::SetScrollY(ImMin(scroll_targets[frame / 2], ImGui::GetScrollMaxY()));
+
+            ImGuiListClipper clipper;
+            clipper.BeginVariableHeight(ImGui::GetID("##items"), items_count, items_height_estimate);
+            if (known_heights && frame == 0)
+                for (int n = 0; n < items_count; n++)
+                    clipper.SetItemHeight(n, ClipperTestItemHeight(n) + spacing_y);
+            const float start_pos_y = window->DC.CursorPos.y;
+            float expected_pos_y = start_pos_y;
+            int expected_pos_item = 0;
+            float displayed_min_y = FLT_MAX, displayed_max_y = -FLT_MAX;
+            while (clipper.Step())
+                for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+                {
+                    if (known_heights)
+                    {
+                        for (; expected_pos_item < n; expected_pos_item++)
+                            expected_pos_y += ClipperTestItemHeight(expected_pos_item) + spacing_y;
+                        if (window->DC.CursorPos.y != expected_pos_y)
+                            positions_mismatches++;
+                    }
+                    displayed_min_y = ImMin(displayed_min_y, window->DC.CursorPos.y);
+                    ImGui::Dummy(ImVec2(10.0f, ClipperTestItemHeight(n)));
+                    displayed_max_y = ImMax(displayed_max_y, window->DC.CursorPos.y);
+                    measured[n] = true;
+                }
+            if (displayed_min_y > ImMax(window->ClipRect.Min.y, start_pos_y) || displayed_max_y < ImMin(window->ClipRect.Max.y, window->DC.CursorMaxPos.y))
+                coverage_errors++;
+            ImGui::End();
+            ImGui::Render();
+
+            // Last item has no trailing spacing
+            expected_content_height = -spacing_y;
+            for (int n = 0; n < items_count; n++)
+                expected_content_height += measured[n] ? ClipperTestItemHeight(n) + spacing_y : items_height_estimate;
+        }
+        IM_CHECK(positions_mismatches == 0);
+        IM_CHECK(coverage_errors == 0);
+    }
+    ImGui::DestroyContext();
+}
+
+//-----------------------------------------------------------------------------
+
+int main(int, char**)
+{
+    IMGUI_CHECKVERSION();
+    TestFontAtlasCache();
+    TestTextWrapMixedUtf8();
+    TestClipperVariableHeight();
+    printf("%d checks, %d failed\n", g_checks_count, g_checks_failed);
+    return (g_checks_failed > 0) ? 1 : 0;
+}